@@ -18,6 +18,6 @@ namespace GreeksCalculator {
             term2 = -q * S * exp_dividend(q, T) * normal_cdf(-d1);
             term3 = r * K * safe_exp(-r * T) * normal_cdf(-d2);
         }
-        return scale_theta(term1 - term2 + term3, scaling);
+        return scale_theta(term1 + term2 + term3, scaling);
     }
 }
\ No newline at end of file
@@ -14,7 +14,6 @@ namespace GreeksCalculator {
         double term2 = exp_dividend(q, T) * normal_pdf(d1) * safe_divide((2.0 * (r - q) * T - d2 * sigma_sqrt_time(sigma, T)), (2.0 * T * sigma_sqrt_time(sigma, T)));
         if (!call) {
             term1 = -q * exp_dividend(q, T) * normal_cdf(-d1);
-            term2 = -exp_dividend(q, T) * normal_pdf(d1) * safe_divide((2.0 * (r - q) * T - d2 * sigma_sqrt_time(sigma, T)), (2.0 * T * sigma_sqrt_time(sigma, T)));
         }
         return scale_charm(term1 - term2, scaling);
     }
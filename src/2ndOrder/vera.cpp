@@ -9,6 +9,6 @@ namespace GreeksCalculator {
     double calculate_vera(double S, double K, double T, double r, double sigma, double q, const ScalingParams& scaling) {
         double d1 = calculate_d1(S, K, T, r, sigma, q);
         double d2 = calculate_d2(S, K, T, r, sigma, q);
-        return scale_rho(-K * T * safe_exp(-r * T) * normal_pdf(d2) * sqrt_time(T) * d1, scaling);
+        return scale_rho(-K * T * safe_exp(-r * T) * normal_pdf(d2) * safe_divide(d1, sigma), scaling);
     }
 }
\ No newline at end of file
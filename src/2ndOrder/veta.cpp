@@ -9,7 +9,8 @@ namespace GreeksCalculator {
     double calculate_veta(double S, double K, double T, double r, double sigma, double q, const ScalingParams& scaling) {
         double d1 = calculate_d1(S, K, T, r, sigma, q);
         double d2 = calculate_d2(S, K, T, r, sigma, q);
-        double term = -S * exp_dividend(q, T) * normal_pdf(d1) * sqrt_time(T) * (q + safe_divide((r - q - d1 * sigma / (2.0 * T)) * d2, sigma));
+        double term = S * exp_dividend(q, T) * normal_pdf(d1) * sqrt_time(T) *
+                      (q + safe_divide((r - q) * d1, sigma_sqrt_time(sigma, T)) - (1.0 + d1 * d2) / (2.0 * T));
         return scale_vega(scale_charm(term, scaling), scaling);
     }
 }
\ No newline at end of file
@@ -1,13 +1,19 @@
 #include "Greeks.h"
+#include "bsm/spot_derivatives.h"
 #include "math/d1.h"
 #include "math/common.h"
 #include "math/maths.h"
 
 namespace GreeksCalculator {
+    double detail::hexema_from_pounce(double pounce, double S, double d1, double v) {
+        double v2 = v * v;
+        double term = d1 * d1 * d1 * d1 * d1 - 11.0 * d1 * d1 * d1 * d1 / v + 49.0 * d1 * d1 * d1 / v2 - 69.0 * d1 * d1 / (v2 * v) + 39.0 * d1 / (v2 * v2) + 10.0;
+        return pounce * term / S;
+    }
+
     double calculate_hexema(double S, double K, double T, double r, double sigma, double q) {
         double pounce = calculate_pounce(S, K, T, r, sigma, q);
         double d1 = calculate_d1(S, K, T, r, sigma, q);
-        double term = d1 * d1 * d1 * d1 * d1 - 11.0 * d1 * d1 * d1 * d1 / sigma_sqrt_time(sigma, T) + 49.0 * d1 * d1 * d1 / (sigma * sigma * T) - 69.0 * d1 * d1 / (sigma * sigma * sigma * pow(sqrt_time(T), 3)) + 39.0 * d1 / (sigma * sigma * sigma * sigma * pow(sqrt_time(T), 4)) + 10.0;
-        return pounce * term / S;
+        return detail::hexema_from_pounce(pounce, S, d1, sigma_sqrt_time(sigma, T));
     }
 }
\ No newline at end of file
@@ -104,5 +104,8 @@ namespace GreeksCalculator {
     double calculate_hexema(double S, double K, double T, double r, double sigma, double q = 0.0);
     double calculate_mixed6th(double S, double K, double T, double r, double sigma, double q = 0.0);
 
+    // calculate_all leaves the 4th, 5th and 6th order blocks as NaN outside these T/sigma ranges.
+    bool higher_order_enabled(int order, double T, double sigma);
+
     Greeks calculate_all(bool call, double S, double K, double T, double r, double sigma, double q = 0.0, const ScalingParams& scaling = ScalingParams::standard());
 }
\ No newline at end of file
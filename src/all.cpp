@@ -1,6 +1,18 @@
 #include "Greeks.h"
+#include "bsm/spot_derivatives.h"
+#include "math/common.h"
+#include "math/d1.h"
 
 namespace GreeksCalculator {
+    bool higher_order_enabled(int order, double T, double sigma) {
+        switch (order) {
+            case 4: return T > 1.0 / 365.0 && sigma > 0.05;
+            case 5: return T > 2.0 / 365.0 && sigma > 0.10;
+            case 6: return T > 5.0 / 365.0 && sigma > 0.15;
+            default: return order < 4;
+        }
+    }
+
     Greeks calculate_all(bool call, double S, double K, double T, double r, double sigma, double q, const ScalingParams& scaling) {
         Greeks g;
 
@@ -26,23 +38,30 @@ namespace GreeksCalculator {
 		g.ultima = calculate_ultima(S, K, T, r, sigma, q);
 		g.dvanna_dvol = calculate_dvanna_dvol(S, K, T, r, sigma, q);
 
-		if (T > 1.0 / 365.0 && sigma > 0.05) {
-		g.snap = calculate_snap(S, K, T, r, sigma, q);
+		// One recurrence pass yields every higher spot derivative; crackle, pop, quintema
+		// and hexema reuse them instead of rerunning it.
+		if (higher_order_enabled(4, T, sigma)) {
+		double spot[7];
+		int spot_order = higher_order_enabled(6, T, sigma) ? 6 : higher_order_enabled(5, T, sigma) ? 5 : 4;
+		spot_derivatives(call, S, K, T, r, sigma, q, spot_order, spot, nullptr, nullptr, 4);
+		double d1 = calculate_d1(S, K, T, r, sigma, q);
+		double v = sigma_sqrt_time(sigma, T);
+		g.snap = spot[4];
 		g.zed_zeta = calculate_zed_zeta(S, K, T, r, sigma, q);
-		g.crackle = calculate_crackle(S, K, T, r, sigma, q);
-		g.pop = calculate_pop(S, K, T, r, sigma, q);
-        }
+		g.crackle = detail::crackle_from_snap(spot[4], S, d1, v);
+		g.pop = detail::pop_from_snap(spot[4], S, d1, v);
 
-		if (T > 2.0 / 365.0 && sigma > 0.10) {
-		g.jounce = calculate_jounce(S, K, T, r, sigma, q);
-		g.quintema = calculate_quintema(S, K, T, r, sigma, q);
-		g.mixed5th = calculate_mixed5th(S, K, T, r, sigma, q);
-        }
+		if (spot_order >= 5) {
+			g.jounce = spot[5];
+			g.quintema = detail::quintema_from_jounce(spot[5], S, d1, v);
+			g.mixed5th = calculate_mixed5th(S, K, T, r, sigma, q);
+		}
 
-		if (T > 5.0 / 365.0 && sigma > 0.15) {
-		g.pounce = calculate_pounce(S, K, T, r, sigma, q);
-		g.hexema = calculate_hexema(S, K, T, r, sigma, q);
-		g.mixed6th = calculate_mixed6th(S, K, T, r, sigma, q);
+		if (spot_order >= 6) {
+			g.pounce = spot[6];
+			g.hexema = detail::hexema_from_pounce(spot[6], S, d1, v);
+			g.mixed6th = calculate_mixed6th(S, K, T, r, sigma, q);
+		}
         }
 
         return g;
@@ -0,0 +1,347 @@
+#include "approx/chebyshev.h"
+#include "bsm/validation.h"
+#include "math/cdf.h"
+#include "math/common.h"
+#include "math/maths.h"
+#include "math/pdf.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    namespace {
+        constexpr int kFunctions = static_cast<int>(TableFunction::Count);
+        constexpr int kMaxDegree = 15;
+        constexpr char kMagic[8] = {'O', 'Q', 'G', 'C', 'H', 'E', 'B', '3'};
+        constexpr std::uint32_t kFormatVersion = 3;     // 3: max_error holds the derived bound
+
+        double exact_value(int function, double d) {
+            return function == static_cast<int>(TableFunction::Cdf) ? normal_cdf(d) : normal_pdf(d);
+        }
+
+        std::uint64_t fnv1a(const void* data, std::size_t size, std::uint64_t h = 1469598103934665603ull) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                h = (h ^ p[i]) * 1099511628211ull;
+            }
+            return h;
+        }
+
+        // Clenshaw recurrence for sum_j c_j T_j(t).
+        double clenshaw(const double* c, int n, double t) {
+            double b1 = 0.0, b2 = 0.0;
+            for (int j = n - 1; j >= 1; --j) {
+                double b0 = 2.0 * t * b1 - b2 + c[j];
+                b2 = b1;
+                b1 = b0;
+            }
+            return t * b1 - b2 + c[0];
+        }
+
+        // Rounding error of clenshaw() for |t| <= 1. Step j adds at most 3 eps (2 |b_(j+1)|
+        // + |b_(j+2)| + |c_j|), which reaches the result scaled by |U_(j-1)(t)| <= j, and
+        // |b_j| <= sum_(i >= j) (i - j + 1) |c_i|.
+        double clenshaw_error(const double* c, int n) {
+            double b[kMaxDegree + 3] = {};
+            for (int j = n - 1; j >= 0; --j) {
+                for (int i = j; i < n; ++i) {
+                    b[j] += (i - j + 1) * std::abs(c[i]);
+                }
+            }
+            double sum = 3.0 * (b[1] + b[2] + std::abs(c[0]));
+            for (int j = 1; j < n; ++j) {
+                sum += 3.0 * j * (2.0 * b[j + 1] + b[j + 2] + std::abs(c[j]));
+            }
+            return sum * std::numeric_limits<double>::epsilon();
+        }
+
+        // Bound on |d^m/dx^m phi(x)| = |He_m(x)| phi(x) over |x| >= x0, from Cramer's
+        // inequality |He_m(x)| exp(-x^2 / 4) <= 1.086435 sqrt(m!).
+        double hermite_bound(int m, double x0) {
+            return 1.086435 * std::sqrt(std::tgamma(m + 1.0)) * std::exp(-0.25 * x0 * x0) / std::sqrt(2.0 * M_PI);
+        }
+
+        // erfc and exp are taken to be accurate to this many ulps; the rounding of the
+        // argument (x / sqrt(2), x^2 / 2) is accounted for separately.
+        constexpr double kReferenceUlps = 4.0;
+
+        double reference_error(int function, double d) {
+            const double eps = std::numeric_limits<double>::epsilon();
+            double pdf = normal_pdf(d);
+            if (function == static_cast<int>(TableFunction::Cdf)) {
+                return eps * (kReferenceUlps * normal_cdf(d) + 2.0 * std::abs(d) * pdf);
+            }
+            return eps * (kReferenceUlps + 2.0 + d * d) * pdf;
+        }
+
+        void check_spec(const ChebyshevTableSpec& s) {
+            if (!(s.d_max > 0.0) || s.cells <= 0 || s.degree < 1 || s.degree > kMaxDegree) {
+                throw std::invalid_argument("Invalid Chebyshev table specification.");
+            }
+        }
+    }
+
+    ChebyshevBlackTable ChebyshevBlackTable::build(const ChebyshevTableSpec& spec) {
+        check_spec(spec);
+        ChebyshevBlackTable t;
+        t.spec_ = spec;
+        t.cell_scale_ = spec.cells / (2.0 * spec.d_max);
+
+        const int n = spec.degree + 1;
+        const double h = 2.0 * spec.d_max / spec.cells;
+        t.coefficients_.assign(static_cast<std::size_t>(spec.cells) * kFunctions * n, 0.0);
+
+        // Interpolate at Chebyshev nodes of the first kind: c_j = (2 - [j == 0]) / n * sum_a f(x_a) T_j(x_a).
+        std::vector<double> nodes(n), samples(n);
+        for (int a = 0; a < n; ++a) {
+            nodes[a] = std::cos(M_PI * (a + 0.5) / n);
+        }
+        for (int cell = 0; cell < spec.cells; ++cell) {
+            double lo = -spec.d_max + cell * h;
+            for (int f = 0; f < kFunctions; ++f) {
+                for (int a = 0; a < n; ++a) {
+                    samples[a] = exact_value(f, lo + 0.5 * h * (nodes[a] + 1.0));
+                }
+                double* c = &t.coefficients_[(static_cast<std::size_t>(cell) * kFunctions + f) * n];
+                for (int j = 0; j < n; ++j) {
+                    double sum = 0.0;
+                    for (int a = 0; a < n; ++a) {
+                        sum += samples[a] * std::cos(M_PI * j * (a + 0.5) / n);
+                    }
+                    c[j] = (j == 0 ? 1.0 : 2.0) * sum / n;
+                }
+            }
+        }
+
+        // Error bound per cell, for f = N (derivative k is He_(k-1) phi) and f = phi (He_k phi):
+        //   interpolation  (h / 2)^n / (2^(n-1) n!) sup |f^(n)|
+        //   coefficients   Lambda_n * (residual at the nodes + its rounding), where the stored
+        //                  polynomial minus the exact interpolant has degree n - 1 and so is
+        //                  bounded by the Lebesgue constant Lambda_n times its node values
+        //   evaluation     Clenshaw rounding, plus the rounding of t moving d by
+        //                  (4 g + 1) eps h / 2 for cell coordinate g
+        // The derivative terms use twice sup |f'| to cover the polynomial's slope.
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double lebesgue = 1.0 + 2.0 / M_PI * std::log(n + 1.0);
+        double factorial = 1.0;
+        for (int k = 2; k <= n; ++k) {
+            factorial *= k;
+        }
+        const double interpolation_scale = std::pow(0.5 * h, n) / (std::ldexp(1.0, n - 1) * factorial);
+        for (int f = 0; f < kFunctions; ++f) {
+            const int shift = f == static_cast<int>(TableFunction::Cdf) ? -1 : 0;    // f^(k) = He_(k + shift) phi
+            double worst = 0.0;
+            for (int cell = 0; cell < spec.cells; ++cell) {
+                double lo = -spec.d_max + cell * h, hi = lo + h;
+                double x0 = lo <= 0.0 && hi >= 0.0 ? 0.0 : std::min(std::abs(lo), std::abs(hi));
+                double slope = 2.0 * hermite_bound(1 + shift, x0);
+                const double* c = &t.coefficients_[(static_cast<std::size_t>(cell) * kFunctions + f) * n];
+                double rounding = clenshaw_error(c, n);
+
+                double residual = 0.0;
+                for (int a = 0; a < n; ++a) {
+                    double d = lo + 0.5 * h * (nodes[a] + 1.0);
+                    double node_shift = slope * eps * (h + 2.0 * (std::abs(lo) + h));
+                    residual = std::max(residual, std::abs(clenshaw(c, n, nodes[a]) - exact_value(f, d)) +
+                                                      reference_error(f, d) + node_shift);
+                }
+                double bound = interpolation_scale * hermite_bound(n + shift, x0) + lebesgue * (residual + rounding) +
+                               rounding + slope * (4.0 * (cell + 1) + 1.0) * eps * 0.5 * h;
+                worst = std::max(worst, bound);
+            }
+            t.max_error_[f] = worst;
+        }
+
+        // The bound must dominate the error actually seen on 8 points per node interval,
+        // including every cell edge; anything else means an assumption above is wrong.
+        const int checks = 8 * n;
+        for (int f = 0; f < kFunctions; ++f) {
+            for (int cell = 0; cell < spec.cells; ++cell) {
+                double lo = -spec.d_max + cell * h;
+                for (int a = 0; a <= checks; ++a) {
+                    double d = std::min(lo + h * a / checks, spec.d_max);
+                    if (std::abs(t.interpolate(f, d) - exact_value(f, d)) > t.max_error_[f]) {
+                        throw std::logic_error("Chebyshev table error exceeds its derived bound.");
+                    }
+                }
+            }
+        }
+        return t;
+    }
+
+    double ChebyshevBlackTable::interpolate(int function, double d) const {
+        const int n = spec_.degree + 1;
+        double g = (d + spec_.d_max) * cell_scale_;
+        int cell = std::min(static_cast<int>(g), spec_.cells - 1);
+        double t = 2.0 * (g - cell) - 1.0;
+        return clenshaw(&coefficients_[(static_cast<std::size_t>(cell) * kFunctions + function) * n], n, t);
+    }
+
+    bool ChebyshevBlackTable::contains(double k, double v) const {
+        if (!(v > 0.0)) {
+            return false;
+        }
+        double d1 = k / v + 0.5 * v;
+        return std::abs(d1) <= spec_.d_max && std::abs(d1 - v) <= spec_.d_max;
+    }
+
+    bool ChebyshevBlackTable::evaluate(double k, double v, Values& out, bool call) const {
+        if (!contains(k, v)) {
+            return false;
+        }
+        double d1 = k / v + 0.5 * v;
+        double sign = call ? 1.0 : -1.0;
+        out.cdf_d1 = interpolate(static_cast<int>(TableFunction::Cdf), sign * d1);
+        out.cdf_d2 = interpolate(static_cast<int>(TableFunction::Cdf), sign * (d1 - v));
+        out.pdf_d1 = interpolate(static_cast<int>(TableFunction::Pdf), d1);
+        return true;
+    }
+
+    double ChebyshevBlackTable::max_error(TableFunction f) const {
+        int i = static_cast<int>(f);
+        return (i >= 0 && i < kFunctions) ? max_error_[i] : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    void ChebyshevBlackTable::save(const std::string& path) const {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file) {
+            throw std::runtime_error("Cannot write Chebyshev table: " + path);
+        }
+        std::uint64_t count = coefficients_.size();
+        std::uint64_t checksum = fnv1a(&spec_, sizeof(spec_));
+        checksum = fnv1a(max_error_, sizeof(max_error_), checksum);
+        checksum = fnv1a(coefficients_.data(), count * sizeof(double), checksum);
+
+        file.write(kMagic, sizeof(kMagic));
+        file.write(reinterpret_cast<const char*>(&kFormatVersion), sizeof(kFormatVersion));
+        file.write(reinterpret_cast<const char*>(&spec_), sizeof(spec_));
+        file.write(reinterpret_cast<const char*>(max_error_), sizeof(max_error_));
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(coefficients_.data()), static_cast<std::streamsize>(count * sizeof(double)));
+        file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+        if (!file) {
+            throw std::runtime_error("Failed writing Chebyshev table: " + path);
+        }
+    }
+
+    ChebyshevBlackTable ChebyshevBlackTable::load(const std::string& path) {
+        std::ifstream file(path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Cannot open Chebyshev table: " + path);
+        }
+        char magic[sizeof(kMagic)];
+        std::uint32_t version = 0;
+        ChebyshevBlackTable t;
+        std::uint64_t count = 0, checksum = 0;
+
+        file.read(magic, sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        if (!file || std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 || version != kFormatVersion) {
+            throw std::runtime_error("Not a Chebyshev table (or unsupported version): " + path);
+        }
+        file.read(reinterpret_cast<char*>(&t.spec_), sizeof(t.spec_));
+        file.read(reinterpret_cast<char*>(t.max_error_), sizeof(t.max_error_));
+        file.read(reinterpret_cast<char*>(&count), sizeof(count));
+        if (!file) {
+            throw std::runtime_error("Truncated Chebyshev table: " + path);
+        }
+        check_spec(t.spec_);
+        std::uint64_t n = static_cast<std::uint64_t>(t.spec_.degree + 1);
+        if (count != kFunctions * n * static_cast<std::uint64_t>(t.spec_.cells)) {
+            throw std::runtime_error("Corrupt Chebyshev table header: " + path);
+        }
+        t.coefficients_.resize(count);
+        file.read(reinterpret_cast<char*>(t.coefficients_.data()), static_cast<std::streamsize>(count * sizeof(double)));
+        file.read(reinterpret_cast<char*>(&checksum), sizeof(checksum));
+
+        std::uint64_t expected = fnv1a(&t.spec_, sizeof(t.spec_));
+        expected = fnv1a(t.max_error_, sizeof(t.max_error_), expected);
+        expected = fnv1a(t.coefficients_.data(), count * sizeof(double), expected);
+        if (!file || checksum != expected) {
+            throw std::runtime_error("Chebyshev table checksum mismatch: " + path);
+        }
+        t.cell_scale_ = t.spec_.cells / (2.0 * t.spec_.d_max);
+        return t;
+    }
+
+    namespace {
+        // Fills the kTableGreeks fields of `g` from table values; returns false outside the domain.
+        bool table_greeks(const ChebyshevBlackTable& table, bool call, double S, double K, double T, double r, double sigma,
+                          double q, const ScalingParams& scaling, Greeks& g) {
+            double sqrtT = std::sqrt(T);
+            double v = sigma * sqrtT;
+            double k = std::log(S / K) + (r - q) * T;
+            ChebyshevBlackTable::Values n;
+            if (!table.evaluate(k, v, n, call)) {
+                return false;
+            }
+
+            double dq = std::exp(-q * T);
+            double Sq = S * dq;
+            double Kr = K * std::exp(-r * T);
+            double d1 = k / v + 0.5 * v;
+            double d2 = d1 - v;
+            double vega = Sq * n.pdf_d1 * sqrtT;
+
+            // For puts the table returned N(-d1) and N(-d2).
+            g.price = call ? Sq * n.cdf_d1 - Kr * n.cdf_d2 : Kr * n.cdf_d2 - Sq * n.cdf_d1;
+            g.delta = call ? dq * n.cdf_d1 : -dq * n.cdf_d1;
+            g.vega = scale_vega(vega, scaling);
+            g.rho = scale_rho(call ? T * Kr * n.cdf_d2 : -T * Kr * n.cdf_d2, scaling);
+            g.lambda = safe_divide(g.delta * S, g.price);
+            g.epsilon = scale_epsilon(call ? -T * Sq * n.cdf_d1 : T * Sq * n.cdf_d1, scaling);
+            g.gamma = dq * n.pdf_d1 / (S * v);
+            g.vanna = scale_vega(-dq * n.pdf_d1 * d2 / sigma, scaling);
+            g.volga = scale_vega(vega * d1 * d2 / sigma, scaling);
+            return true;
+        }
+    }
+
+    Greeks approx_greeks(const ChebyshevBlackTable& table, bool call, double S, double K, double T, double r, double sigma,
+                         double q, const ScalingParams& scaling) {
+        Greeks g;
+        if (!table_greeks(table, call, S, K, T, r, sigma, q, scaling, g)) {
+            for (int c = 0; c < kGreekColumnCount; ++c) {
+                if (kTableGreeks & greek_bit(static_cast<GreekColumn>(c))) {
+                    greek_field(g, static_cast<GreekColumn>(c)) = evaluate_greek(static_cast<GreekColumn>(c), call, S, K, T, r, sigma, q, scaling);
+                }
+            }
+        }
+        return g;
+    }
+
+    namespace {
+        struct ChebyshevKernel {
+            const ChebyshevBlackTable& table;
+            ScalingParams scaling;
+
+            bool valid(double S, double K, double T, double r, double sigma, double q) const {
+                return inputs_valid(S, K, T, r, sigma, q);
+            }
+
+            void operator()(GreekMask columns, bool call, double S, double K, double T, double r, double sigma, double q, Greeks& g) const {
+                if (!(columns & kTableGreeks) || !table_greeks(table, call, S, K, T, r, sigma, q, scaling, g)) {
+                    BsmKernel{scaling}(columns, call, S, K, T, r, sigma, q, g);
+                    return;
+                }
+                // Wide requests make BsmKernel overwrite every field, so keep the table values apart.
+                GreekMask exact = columns & ~kTableGreeks;
+                Greeks rest;
+                BsmKernel{scaling}(exact, call, S, K, T, r, sigma, q, rest);
+                for (int c = 0; c < kGreekColumnCount; ++c) {
+                    if (exact & greek_bit(static_cast<GreekColumn>(c))) {
+                        greek_field(g, static_cast<GreekColumn>(c)) = greek_field(rest, static_cast<GreekColumn>(c));
+                    }
+                }
+            }
+        };
+    }
+
+    std::size_t approx_batch_greeks(const ChebyshevBlackTable& table, const BatchInputs& in, const BatchOutputs& out,
+                                    const ScalingParams& scaling, int threads) {
+        return batch_evaluate(in, out, ChebyshevKernel{table, scaling}, threads);
+    }
+}
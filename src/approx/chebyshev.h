@@ -0,0 +1,84 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/batch.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace GreeksCalculator {
+    // Resolution of a ChebyshevBlackTable. Under BSM every supported Greek is a
+    // scale factor times N(d1), N(d2) or phi(d1), where d1 = k / v + v / 2 and
+    // d2 = d1 - v for log-moneyness k = log(F / K) and total volatility
+    // v = sigma * sqrt(T). So the whole (k, v) surface is generated by two
+    // one-dimensional functions. Those are stored as piecewise Chebyshev
+    // polynomials on uniform cells over [-d_max, d_max], which keeps the table
+    // small enough to stay in cache.
+    struct ChebyshevTableSpec {
+        double d_max = 9.0;
+        int cells = 1024;
+        int degree = 5;         // Polynomial degree per cell
+    };
+
+    enum class TableFunction : int {
+        Cdf,              // N(d)
+        Pdf,              // phi(d)
+        Count
+    };
+
+    class ChebyshevBlackTable {
+    public:
+        // For puts cdf_d1 and cdf_d2 hold N(-d1) and N(-d2), read from the table
+        // directly: 1 - N(d) would cancel in the deep out-of-the-money put wing.
+        struct Values {
+            double cdf_d1;
+            double cdf_d2;
+            double pdf_d1;
+        };
+
+        // Fits the table and derives its error bound per cell from the interpolation
+        // remainder, the Lebesgue constant and the rounding of coefficients and
+        // evaluation, assuming erfc and exp accurate to 4 ulps. Throws
+        // std::logic_error if a dense sample of the table ever exceeds that bound.
+        static ChebyshevBlackTable build(const ChebyshevTableSpec& spec = ChebyshevTableSpec{});
+
+        // Versioned, checksummed binary format; load() throws std::runtime_error on mismatch.
+        static ChebyshevBlackTable load(const std::string& path);
+        void save(const std::string& path) const;
+
+        // Evaluation in normalized Black coordinates. The domain is every (k, v)
+        // with v > 0 and both d1 and d2 inside [-d_max, d_max].
+        bool contains(double k, double v) const;
+        // Returns false (leaving `out` untouched) outside the table domain.
+        bool evaluate(double k, double v, Values& out, bool call = true) const;
+
+        // Bound on |table - exact| for each function over [-d_max, d_max], rounding included.
+        double max_error(TableFunction f) const;
+        const ChebyshevTableSpec& spec() const { return spec_; }
+        std::size_t memory_bytes() const { return coefficients_.size() * sizeof(double); }
+
+    private:
+        double interpolate(int function, double d) const;
+
+        ChebyshevTableSpec spec_;
+        double cell_scale_ = 0.0;
+        double max_error_[static_cast<int>(TableFunction::Count)] = {};
+        // Per cell: degree+1 coefficients for each TableFunction.
+        std::vector<double> coefficients_;
+    };
+
+    // Columns served from the table; any other requested column falls back to the exact formula.
+    constexpr GreekMask kTableGreeks = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) |
+                                       greek_bit(GreekColumn::Vega) | greek_bit(GreekColumn::Rho) |
+                                       greek_bit(GreekColumn::Lambda) | greek_bit(GreekColumn::Epsilon) |
+                                       greek_bit(GreekColumn::Gamma) | greek_bit(GreekColumn::Vanna) |
+                                       greek_bit(GreekColumn::Volga);
+
+    // Table-based price and Greeks for kTableGreeks. Outside the table domain the
+    // exact calculate_* results are returned instead; other fields stay NaN.
+    Greeks approx_greeks(const ChebyshevBlackTable& table, bool call, double S, double K, double T, double r, double sigma,
+                         double q = 0.0, const ScalingParams& scaling = ScalingParams::standard());
+
+    // Opt-in table-backed counterpart of batch_greeks with the same inputs, outputs and status handling.
+    std::size_t approx_batch_greeks(const ChebyshevBlackTable& table, const BatchInputs& in, const BatchOutputs& out,
+                                    const ScalingParams& scaling = ScalingParams::standard(), int threads = 0);
+}
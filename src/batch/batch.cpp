@@ -0,0 +1,60 @@
+#include "batch/batch.h"
+#include "bsm/impliedvol.h"
+#include "math/maths.h"
+#include <bitset>
+
+namespace GreeksCalculator {
+    namespace {
+        // With this many columns requested it is cheaper to run calculate_all once
+        // than to re-derive d1/d2 in every per-column call.
+        constexpr std::size_t kFullEvaluationThreshold = 12;
+    }
+
+    void BsmKernel::operator()(GreekMask columns, bool call, double S, double K, double T, double r, double sigma, double q, Greeks& g) const {
+        if (std::bitset<64>(columns).count() >= kFullEvaluationThreshold) {
+            g = calculate_all(call, S, K, T, r, sigma, q, scaling);
+            return;
+        }
+        for (int c = 0; c < kGreekColumnCount; ++c) {
+            if (columns & greek_bit(static_cast<GreekColumn>(c))) {
+                greek_field(g, static_cast<GreekColumn>(c)) = evaluate_greek(static_cast<GreekColumn>(c), call, S, K, T, r, sigma, q, scaling);
+            }
+        }
+    }
+
+    std::size_t batch_greeks(const BatchInputs& in, const BatchOutputs& out, const ScalingParams& scaling, int threads) {
+        return batch_evaluate(in, out, BsmKernel{scaling}, threads);
+    }
+
+    std::size_t batch_implied_volatility(const BatchInputs& in, StridedView<const double> market_price,
+                                         StridedView<double> out_sigma, StridedView<std::int32_t> status, int threads) {
+        return detail::for_each_row(in.count, threads, [&](std::size_t i) {
+            bool call = in.call ? in.call[i] != 0 : true;
+            double S = in.S[i], K = in.K[i], T = in.T[i], r = in.r[i];
+            double q = in.q ? in.q[i] : 0.0;
+            double price = market_price[i];
+            BatchStatus s = BatchStatus::Ok;
+            double iv = std::numeric_limits<double>::quiet_NaN();
+
+            if (!inputs_valid(S, K, T, r, 0.1, q) || !(price > 0.0)) {
+                s = BatchStatus::InvalidInput;
+            } else {
+                iv = calculate_implied_volatility(call, S, K, T, r, price, q);
+                if (!is_valid(iv)) {
+                    s = BatchStatus::NoConvergence;
+                }
+            }
+
+            out_sigma[i] = iv;
+            if (status) {
+                status[i] = static_cast<std::int32_t>(s);
+            }
+            return s;
+        }, [&](std::size_t i) {
+            out_sigma[i] = std::numeric_limits<double>::quiet_NaN();
+            if (status) {
+                status[i] = static_cast<std::int32_t>(BatchStatus::Error);
+            }
+        });
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/columns.h"
+#include "bsm/validation.h"
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace GreeksCalculator {
+    // Non-owning view over caller memory. Stride is in elements; a stride of 0
+    // broadcasts element 0 to every row (e.g. one rate for the whole batch).
+    template <typename T>
+    struct StridedView {
+        T* data = nullptr;
+        std::ptrdiff_t stride = 1;
+
+        T& operator[](std::size_t i) const { return data[static_cast<std::ptrdiff_t>(i) * stride]; }
+        explicit operator bool() const { return data != nullptr; }
+    };
+
+    enum class BatchStatus : std::int32_t {
+        Ok = 0,
+        InvalidInput = 1,     // Row failed inputs_valid (or had a non-positive market price)
+        NoConvergence = 2,    // Implied volatility solver did not converge
+        Error = 3,            // Unexpected failure while evaluating the row
+    };
+
+    struct BatchInputs {
+        std::size_t count = 0;
+        StridedView<const std::uint8_t> call;   // Non-zero for calls; null means every row is a call
+        StridedView<const double> S;
+        StridedView<const double> K;
+        StridedView<const double> T;
+        StridedView<const double> r;
+        StridedView<const double> sigma;        // May be null for kernels that source volatility themselves
+        StridedView<const double> q;            // Optional; null means zero dividend yield
+    };
+
+    struct BatchOutputs {
+        GreekMask columns = 0;                          // Which entries of `greeks` are written
+        StridedView<double> greeks[kGreekColumnCount];
+        StridedView<std::int32_t> status;               // Optional per-row BatchStatus
+    };
+
+    namespace detail {
+        constexpr std::size_t kRowsPerTask = 512;
+
+        // Runs row(i) for every row in parallel chunks; if it throws, fail(i) records
+        // the error instead. Returns the number of rows whose status was not Ok.
+        template <typename Row, typename Fail>
+        std::size_t for_each_row(std::size_t count, int threads, Row row, Fail fail) {
+            std::atomic<std::size_t> failures{0};
+            std::size_t tasks = (count + kRowsPerTask - 1) / kRowsPerTask;
+            parallel_for(tasks, threads, [&](std::size_t t) {
+                std::size_t begin = t * kRowsPerTask;
+                std::size_t end = std::min(count, begin + kRowsPerTask);
+                std::size_t failed = 0;
+                for (std::size_t i = begin; i < end; ++i) {
+                    BatchStatus s;
+                    try {
+                        s = row(i);
+                    } catch (...) {
+                        s = BatchStatus::Error;
+                        fail(i);
+                    }
+                    failed += s != BatchStatus::Ok;
+                }
+                failures.fetch_add(failed, std::memory_order_relaxed);
+            });
+            return failures.load();
+        }
+    }
+
+    // Shared row loop behind every batch entry point. A Kernel provides
+    //   bool valid(double S, double K, double T, double r, double sigma, double q) const;
+    //   void operator()(GreekMask columns, bool call, double S, double K, double T,
+    //                   double r, double sigma, double q, Greeks& g) const;
+    // and must fill at least the requested fields of `g`. The kernel type is a
+    // template parameter, so each kernel gets its own specialized loop.
+    template <typename Kernel>
+    std::size_t batch_evaluate(const BatchInputs& in, const BatchOutputs& out, const Kernel& kernel, int threads = 0) {
+        const GreekMask mask = out.columns & kAllGreeks;
+        auto finish = [&](std::size_t i, const Greeks* g, BatchStatus status) {
+            for (int c = 0; c < kGreekColumnCount; ++c) {
+                if (mask & greek_bit(static_cast<GreekColumn>(c))) {
+                    out.greeks[c][i] = g ? greek_field(*g, static_cast<GreekColumn>(c)) : std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+            if (out.status) {
+                out.status[i] = static_cast<std::int32_t>(status);
+            }
+            return status;
+        };
+
+        return detail::for_each_row(in.count, threads, [&](std::size_t i) {
+            bool call = in.call ? in.call[i] != 0 : true;
+            double S = in.S[i], K = in.K[i], T = in.T[i], r = in.r[i];
+            double sigma = in.sigma ? in.sigma[i] : std::numeric_limits<double>::quiet_NaN();
+            double q = in.q ? in.q[i] : 0.0;
+            if (!kernel.valid(S, K, T, r, sigma, q)) {
+                return finish(i, nullptr, BatchStatus::InvalidInput);
+            }
+            Greeks g;
+            kernel(mask, call, S, K, T, r, sigma, q, g);
+            return finish(i, &g, BatchStatus::Ok);
+        }, [&](std::size_t i) { finish(i, nullptr, BatchStatus::Error); });
+    }
+
+    // Exact Black-Scholes-Merton kernel used by batch_greeks.
+    struct BsmKernel {
+        ScalingParams scaling = ScalingParams::standard();
+
+        bool valid(double S, double K, double T, double r, double sigma, double q) const {
+            return inputs_valid(S, K, T, r, sigma, q);
+        }
+        void operator()(GreekMask columns, bool call, double S, double K, double T, double r, double sigma, double q, Greeks& g) const;
+    };
+
+    // Evaluates the requested columns for every row, split across `threads`
+    // workers (0 = all cores). Invalid rows get NaN outputs and a status code
+    // instead of throwing. Returns the number of rows that were not Ok.
+    std::size_t batch_greeks(const BatchInputs& in, const BatchOutputs& out,
+                             const ScalingParams& scaling = ScalingParams::standard(), int threads = 0);
+
+    // Batch form of calculate_implied_volatility; `in.sigma` is ignored.
+    std::size_t batch_implied_volatility(const BatchInputs& in, StridedView<const double> market_price,
+                                         StridedView<double> out_sigma, StridedView<std::int32_t> status = {},
+                                         int threads = 0);
+}
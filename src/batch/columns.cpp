@@ -0,0 +1,111 @@
+#include "batch/columns.h"
+#include <cstring>
+
+namespace GreeksCalculator {
+    namespace {
+        constexpr double Greeks::* kFields[kGreekColumnCount] = {
+            &Greeks::price, &Greeks::delta, &Greeks::vega, &Greeks::theta, &Greeks::rho, &Greeks::lambda, &Greeks::epsilon,
+            &Greeks::gamma, &Greeks::vanna, &Greeks::charm, &Greeks::volga, &Greeks::veta, &Greeks::vera, &Greeks::dual_rho,
+            &Greeks::speed, &Greeks::zomma, &Greeks::color, &Greeks::ultima, &Greeks::dvanna_dvol,
+            &Greeks::snap, &Greeks::zed_zeta, &Greeks::crackle, &Greeks::pop,
+            &Greeks::jounce, &Greeks::quintema, &Greeks::mixed5th,
+            &Greeks::pounce, &Greeks::hexema, &Greeks::mixed6th,
+        };
+
+        constexpr const char* kNames[kGreekColumnCount] = {
+            "price", "delta", "vega", "theta", "rho", "lambda", "epsilon",
+            "gamma", "vanna", "charm", "volga", "veta", "vera", "dual_rho",
+            "speed", "zomma", "color", "ultima", "dvanna_dvol",
+            "snap", "zed_zeta", "crackle", "pop",
+            "jounce", "quintema", "mixed5th",
+            "pounce", "hexema", "mixed6th",
+        };
+    }
+
+    double& greek_field(Greeks& g, GreekColumn c) {
+        return g.*kFields[static_cast<int>(c)];
+    }
+
+    double greek_field(const Greeks& g, GreekColumn c) {
+        return g.*kFields[static_cast<int>(c)];
+    }
+
+    const char* greek_name(GreekColumn c) {
+        int i = static_cast<int>(c);
+        return (i >= 0 && i < kGreekColumnCount) ? kNames[i] : "";
+    }
+
+    // Greeks is kGreekColumnCount doubles in column order, so the full set is one copy.
+    static_assert(sizeof(Greeks) == kGreekColumnCount * sizeof(double), "Greeks layout");
+
+    std::size_t pack_greeks(GreekMask columns, const Greeks& g, double* out) {
+        if ((columns & kAllGreeks) == kAllGreeks) {
+            std::memcpy(out, &g, sizeof(Greeks));
+            return kGreekColumnCount;
+        }
+        std::size_t k = 0;
+        for (int c = 0; c < kGreekColumnCount; ++c) {
+            if (columns & greek_bit(static_cast<GreekColumn>(c))) {
+                out[k++] = g.*kFields[c];
+            }
+        }
+        return k;
+    }
+
+    std::size_t unpack_greeks(GreekMask columns, const double* values, Greeks& g) {
+        if ((columns & kAllGreeks) == kAllGreeks) {
+            std::memcpy(static_cast<void*>(&g), values, sizeof(Greeks));
+            return kGreekColumnCount;
+        }
+        std::size_t k = 0;
+        for (int c = 0; c < kGreekColumnCount; ++c) {
+            if (columns & greek_bit(static_cast<GreekColumn>(c))) {
+                g.*kFields[c] = values[k++];
+            }
+        }
+        return k;
+    }
+
+    double evaluate_greek(GreekColumn c, bool call, double S, double K, double T, double r, double sigma, double q, const ScalingParams& scaling) {
+        switch (c) {
+            case GreekColumn::Price: return calculate_price(call, S, K, T, r, sigma, q);
+            case GreekColumn::Delta: return calculate_delta(call, S, K, T, r, sigma, q);
+            case GreekColumn::Vega: return calculate_vega(S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Theta: return calculate_theta(call, S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Rho: return calculate_rho(call, S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Lambda: return calculate_lambda(call, S, K, T, r, sigma, q);
+            case GreekColumn::Epsilon: return calculate_epsilon(call, S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Gamma: return calculate_gamma(S, K, T, r, sigma, q);
+            case GreekColumn::Vanna: return calculate_vanna(S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Charm: return calculate_charm(call, S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Volga: return calculate_volga(S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Veta: return calculate_veta(S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Vera: return calculate_vera(S, K, T, r, sigma, q, scaling);
+            case GreekColumn::DualRho: return calculate_dual_rho(S, K, T, r, sigma, q, scaling);
+            case GreekColumn::Speed: return calculate_speed(S, K, T, r, sigma, q);
+            case GreekColumn::Zomma: return calculate_zomma(S, K, T, r, sigma, q);
+            case GreekColumn::Color: return calculate_color(S, K, T, r, sigma, q);
+            case GreekColumn::Ultima: return calculate_ultima(S, K, T, r, sigma, q);
+            case GreekColumn::DvannaDvol: return calculate_dvanna_dvol(S, K, T, r, sigma, q);
+            default: break;
+        }
+
+        int order = c < GreekColumn::Jounce ? 4 : (c < GreekColumn::Pounce ? 5 : 6);
+        if (!higher_order_enabled(order, T, sigma)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        switch (c) {
+            case GreekColumn::Snap: return calculate_snap(S, K, T, r, sigma, q);
+            case GreekColumn::ZedZeta: return calculate_zed_zeta(S, K, T, r, sigma, q);
+            case GreekColumn::Crackle: return calculate_crackle(S, K, T, r, sigma, q);
+            case GreekColumn::Pop: return calculate_pop(S, K, T, r, sigma, q);
+            case GreekColumn::Jounce: return calculate_jounce(S, K, T, r, sigma, q);
+            case GreekColumn::Quintema: return calculate_quintema(S, K, T, r, sigma, q);
+            case GreekColumn::Mixed5th: return calculate_mixed5th(S, K, T, r, sigma, q);
+            case GreekColumn::Pounce: return calculate_pounce(S, K, T, r, sigma, q);
+            case GreekColumn::Hexema: return calculate_hexema(S, K, T, r, sigma, q);
+            case GreekColumn::Mixed6th: return calculate_mixed6th(S, K, T, r, sigma, q);
+            default: return std::numeric_limits<double>::quiet_NaN();
+        }
+    }
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include "Greeks.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace GreeksCalculator {
+    // One entry per `Greeks` field, in declaration order.
+    enum class GreekColumn : int {
+        Price, Delta, Vega, Theta, Rho, Lambda, Epsilon,
+        Gamma, Vanna, Charm, Volga, Veta, Vera, DualRho,
+        Speed, Zomma, Color, Ultima, DvannaDvol,
+        Snap, ZedZeta, Crackle, Pop,
+        Jounce, Quintema, Mixed5th,
+        Pounce, Hexema, Mixed6th,
+        Count
+    };
+
+    constexpr int kGreekColumnCount = static_cast<int>(GreekColumn::Count);
+
+    using GreekMask = std::uint64_t;
+
+    constexpr GreekMask greek_bit(GreekColumn c) {
+        return GreekMask{1} << static_cast<int>(c);
+    }
+
+    constexpr GreekMask kAllGreeks = (GreekMask{1} << kGreekColumnCount) - 1;
+
+    double& greek_field(Greeks& g, GreekColumn c);
+    double greek_field(const Greeks& g, GreekColumn c);
+    const char* greek_name(GreekColumn c);
+
+    // Copies the selected columns of `g` to consecutive values in column order, and back.
+    // Returns the number of values.
+    std::size_t pack_greeks(GreekMask columns, const Greeks& g, double* out);
+    std::size_t unpack_greeks(GreekMask columns, const double* values, Greeks& g);
+
+    // Evaluates a single column exactly as calculate_all would, including its
+    // T/sigma cut-offs for the 4th-6th order blocks.
+    double evaluate_greek(GreekColumn c, bool call, double S, double K, double T, double r, double sigma, double q,
+                          const ScalingParams& scaling = ScalingParams::standard());
+}
@@ -0,0 +1,143 @@
+#include "batch/progressive.h"
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace GreeksCalculator {
+    namespace {
+        // Small enough that workers notice the deadline within a few microseconds even
+        // for the sixth-order tier.
+        constexpr std::size_t kRowsPerTask = 64;
+        // Weight of the latest call in the smoothed per-row time.
+        constexpr double kTimingWeight = 0.25;
+        // Fraction of the remaining time a tier may be planned to use, leaving room for
+        // scheduling noise and a slower-than-usual call.
+        constexpr double kAdmissionHeadroom = 0.9;
+
+        constexpr GreekMask range(GreekColumn first, GreekColumn last) {
+            return ((GreekMask{1} << (static_cast<int>(last) + 1)) - 1) & ~(greek_bit(first) - 1);
+        }
+    }
+
+    GreekMask tier_columns(GreekTier t) {
+        switch (t) {
+            case GreekTier::First: return range(GreekColumn::Price, GreekColumn::Epsilon);
+            case GreekTier::Second: return range(GreekColumn::Gamma, GreekColumn::DualRho);
+            case GreekTier::Third: return range(GreekColumn::Speed, GreekColumn::DvannaDvol);
+            case GreekTier::Fourth: return range(GreekColumn::Snap, GreekColumn::Pop);
+            case GreekTier::Fifth: return range(GreekColumn::Jounce, GreekColumn::Mixed5th);
+            case GreekTier::Sixth: return range(GreekColumn::Pounce, GreekColumn::Mixed6th);
+            default: return 0;
+        }
+    }
+
+    ProgressiveGreeks::ProgressiveGreeks(const ScalingParams& scaling, int threads)
+        : kernel_{scaling}, threads_(threads) {}
+
+    ProgressiveResult ProgressiveGreeks::evaluate(const BatchInputs& in, const BatchOutputs& out,
+                                                  StridedView<TierMask> tiers, Clock::time_point deadline) {
+        ProgressiveResult result;
+        const std::size_t count = in.count;
+        const GreekMask requested = out.columns & kAllGreeks;
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+
+        auto write = [&](std::size_t i, GreekMask columns, const Greeks* g) {
+            for (int c = 0; c < kGreekColumnCount; ++c) {
+                if (columns & greek_bit(static_cast<GreekColumn>(c))) {
+                    out.greeks[c][i] = g ? greek_field(*g, static_cast<GreekColumn>(c)) : nan;
+                }
+            }
+        };
+        auto set_status = [&](std::size_t i, BatchStatus s) {
+            if (out.status) {
+                out.status[i] = static_cast<std::int32_t>(s);
+            }
+        };
+
+        // Validation is cheap next to any tier, so every row gets its status up front.
+        std::vector<std::uint8_t> valid(count);
+        for (std::size_t i = 0; i < count; ++i) {
+            double q = in.q ? in.q[i] : 0.0;
+            valid[i] = kernel_.valid(in.S[i], in.K[i], in.T[i], in.r[i], in.sigma[i], q);
+            tiers[i] = 0;
+            set_status(i, valid[i] ? BatchStatus::Ok : BatchStatus::InvalidInput);
+            result.failures += !valid[i];
+        }
+
+        bool cut = false;
+        for (int t = 0; t < kGreekTierCount; ++t) {
+            const GreekMask columns = requested & tier_columns(static_cast<GreekTier>(t));
+            if (columns == 0) {
+                continue;
+            }
+            TierTiming& timing = timing_[t];
+            if (cut) {
+                timing.deferred += count;
+                continue;
+            }
+
+            Clock::time_point start = Clock::now();
+            std::size_t admit = 0;
+            if (start < deadline) {
+                admit = count;
+                if (timing.rows > 0 && timing.ns_per_row > 0.0) {
+                    double budget = std::chrono::duration<double, std::nano>(deadline - start).count() * kAdmissionHeadroom;
+                    admit = static_cast<std::size_t>(std::min(static_cast<double>(count), budget / timing.ns_per_row));
+                }
+            }
+
+            const TierMask bit = tier_bit(static_cast<GreekTier>(t));
+            std::atomic<std::size_t> done{0};
+            std::atomic<std::size_t> errors{0};
+            std::size_t tasks = (admit + kRowsPerTask - 1) / kRowsPerTask;
+            parallel_for(tasks, threads_, [&](std::size_t task) {
+                if (Clock::now() >= deadline) {
+                    return;
+                }
+                std::size_t begin = task * kRowsPerTask;
+                std::size_t end = std::min(admit, begin + kRowsPerTask);
+                std::size_t failed = 0;
+                for (std::size_t i = begin; i < end; ++i) {
+                    if (!valid[i]) {
+                        write(i, columns, nullptr);
+                    } else {
+                        try {
+                            Greeks g;
+                            kernel_(columns, in.call ? in.call[i] != 0 : true, in.S[i], in.K[i], in.T[i], in.r[i],
+                                    in.sigma[i], in.q ? in.q[i] : 0.0, g);
+                            write(i, columns, &g);
+                        } catch (...) {
+                            write(i, columns, nullptr);
+                            set_status(i, BatchStatus::Error);
+                            valid[i] = 0;
+                            ++failed;
+                        }
+                    }
+                    tiers[i] |= bit;
+                }
+                done.fetch_add(end - begin, std::memory_order_relaxed);
+                errors.fetch_add(failed, std::memory_order_relaxed);
+            });
+
+            std::size_t rows = done.load();
+            result.failures += errors.load();
+            if (rows > 0) {
+                double sample = std::chrono::duration<double, std::nano>(Clock::now() - start).count() / static_cast<double>(rows);
+                timing.ns_per_row = timing.rows == 0 ? sample : timing.ns_per_row + kTimingWeight * (sample - timing.ns_per_row);
+                timing.rows += rows;
+            }
+            timing.deferred += count - rows;
+            result.rows[t] = rows;
+            if (rows == count) {
+                result.complete |= bit;
+            } else {
+                cut = true;
+                result.deadline_reached = true;
+            }
+        }
+        return result;
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include "batch/batch.h"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace GreeksCalculator {
+    // Priority tiers of a progressive evaluation: price and the first-order Greeks, then
+    // each higher-order block of calculate_all.
+    enum class GreekTier : int { First, Second, Third, Fourth, Fifth, Sixth, Count };
+
+    constexpr int kGreekTierCount = static_cast<int>(GreekTier::Count);
+
+    using TierMask = std::uint8_t;
+
+    constexpr TierMask tier_bit(GreekTier t) {
+        return static_cast<TierMask>(1u << static_cast<int>(t));
+    }
+
+    constexpr TierMask kAllTiers = (1u << kGreekTierCount) - 1;
+
+    // The columns computed in tier `t`.
+    GreekMask tier_columns(GreekTier t);
+
+    // Feedback kept per tier between calls.
+    struct TierTiming {
+        double ns_per_row = 0.0;        // Smoothed wall time per row at the evaluator's thread count
+        std::uint64_t rows = 0;         // Rows evaluated so far
+        std::uint64_t deferred = 0;     // Rows left out because of a deadline
+    };
+
+    struct ProgressiveResult {
+        TierMask complete = 0;                      // Tiers present in every row
+        std::size_t rows[kGreekTierCount] = {};     // Rows holding each tier
+        std::size_t failures = 0;                   // Rows whose status is not Ok
+        bool deadline_reached = false;              // Some requested tier was cut short
+    };
+
+    // Batch Black-Scholes-Merton Greeks under a deadline. Tiers are computed in order
+    // across the whole batch, so every row gets its first-order Greeks before any row gets
+    // second-order ones. Before each tier the evaluator admits only as many rows as its
+    // timing of earlier calls says will fit before the deadline, and workers stop picking
+    // up rows once the deadline passes; the tiers after a cut tier are not started.
+    //
+    // One call at a time per evaluator; keep one per thread count and workload so that
+    // its timings stay representative.
+    class ProgressiveGreeks {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit ProgressiveGreeks(const ScalingParams& scaling = ScalingParams::standard(), int threads = 0);
+
+        // Evaluates the columns requested by `out.columns`. `tiers[i]` receives the tiers
+        // written to row i; columns of the other tiers are left untouched. Every row gets
+        // a status (when `out.status` is set) and invalid rows get NaN in each tier they
+        // hold.
+        ProgressiveResult evaluate(const BatchInputs& in, const BatchOutputs& out, StridedView<TierMask> tiers,
+                                   Clock::time_point deadline);
+
+        const TierTiming& timing(GreekTier t) const { return timing_[static_cast<int>(t)]; }
+
+    private:
+        BsmKernel kernel_;
+        int threads_;
+        TierTiming timing_[kGreekTierCount];
+    };
+}
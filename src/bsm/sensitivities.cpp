@@ -0,0 +1,127 @@
+#include "bsm/sensitivities.h"
+#include "bsm/validation.h"
+#include "math/cdf.h"
+#include "math/pdf.h"
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    namespace {
+        constexpr int iS = static_cast<int>(SensitivityVariable::S);
+        constexpr int iV = static_cast<int>(SensitivityVariable::Sigma);
+        constexpr int iR = static_cast<int>(SensitivityVariable::R);
+        constexpr int iQ = static_cast<int>(SensitivityVariable::Q);
+        constexpr int iT = static_cast<int>(SensitivityVariable::T);
+
+        // Everything is built from A = S exp(-qT) phi(d1) = K exp(-rT) phi(d2) and the
+        // partial derivatives of d1 and d2:
+        //   dd1/dS = 1 / (S v)     dd1/dsigma = -d2 / sigma    dd1/dr = -dd1/dq = T / v
+        //   dd1/dT = (r - q) / v - d2 / (2T),  dd2/dT = (r - q) / v - d1 / (2T)
+        void evaluate(bool call, double S, double K, double T, double r, double sigma, double q, PriceSensitivities& out) {
+            double w = call ? 1.0 : -1.0;
+            double sqT = std::sqrt(T), v = sigma * sqT;
+            double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / v, d2 = d1 - v;
+            double dq = std::exp(-q * T), dr = std::exp(-r * T);
+            double Sq = S * dq, Kr = K * dr;
+            double n1 = normal_pdf(d1);
+            double N1 = normal_cdf(w * d1), N2 = normal_cdf(w * d2);
+            double A = Sq * n1;
+            double d1T = (r - q) / v - d2 / (2.0 * T);
+            double d2T = d1T - sigma / (2.0 * sqT);
+
+            double delta = w * dq * N1;
+            double vega = A * sqT;
+            double rho = w * Kr * T * N2;
+            double epsilon = -w * Sq * T * N1;
+            double decay = A * sigma / (2.0 * sqT);     // -theta without the carry terms
+
+            out.price = w * (Sq * N1 - Kr * N2);
+            double* g = out.gradient;
+            g[iS] = delta;
+            g[iV] = vega;
+            g[iR] = rho;
+            g[iQ] = epsilon;
+            g[iT] = decay - q * w * Sq * N1 + r * w * Kr * N2;
+
+            double h[kSensitivityCount][kSensitivityCount];
+            h[iS][iS] = dq * n1 / (S * v);
+            h[iS][iV] = -dq * n1 * d2 / sigma;
+            h[iS][iR] = dq * n1 * T / v;
+            h[iS][iQ] = -dq * n1 * T / v - T * delta;
+            h[iS][iT] = dq * n1 * d1T - q * delta;
+
+            h[iV][iV] = vega * d1 * d2 / sigma;
+            h[iV][iR] = -A * T * d1 / sigma;
+            h[iV][iQ] = vega * T * (d1 / v - 1.0);
+            h[iV][iT] = vega * (0.5 / T - q - d1 * d1T);
+
+            double AT2v = A * T * T / v;
+            h[iR][iR] = AT2v - T * rho;
+            h[iR][iQ] = -AT2v;
+            h[iR][iT] = rho * (1.0 / T - r) + A * T * d2T;
+
+            h[iQ][iQ] = AT2v - T * epsilon;
+            h[iQ][iT] = epsilon * (1.0 / T - q) - A * T * d1T;
+
+            h[iT][iT] = decay * (-q - d1 * d1T - 0.5 / T) + q * q * w * Sq * N1 - r * r * w * Kr * N2 - q * A * d1T +
+                        r * A * d2T;
+
+            for (int i = 0; i < kSensitivityCount; ++i) {
+                for (int j = i; j < kSensitivityCount; ++j) {
+                    out.hessian[i][j] = out.hessian[j][i] = h[i][j];
+                }
+            }
+        }
+    }
+
+    PriceSensitivities price_sensitivities(bool call, double S, double K, double T, double r, double sigma, double q) {
+        validate_inputs(S, K, T, r, sigma, q);
+        PriceSensitivities out;
+        evaluate(call, S, K, T, r, sigma, q, out);
+        return out;
+    }
+
+    std::size_t batch_price_sensitivities(const BatchInputs& in, const SensitivityOutputs& out, int threads) {
+        // `out.gradient = {ptr}` resets the stride to 1, which would let rows overwrite each other.
+        if ((out.gradient && out.gradient.stride < kSensitivityCount) || (out.hessian && out.hessian.stride < kPackedHessianSize)) {
+            throw std::invalid_argument("Sensitivity output strides must be at least 5 (gradient) and 15 (Hessian).");
+        }
+        auto finish = [&](std::size_t i, const PriceSensitivities* s, BatchStatus status) {
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            if (out.price) {
+                out.price[i] = s ? s->price : nan;
+            }
+            if (out.gradient) {
+                double* g = &out.gradient[i];
+                for (int k = 0; k < kSensitivityCount; ++k) {
+                    g[k] = s ? s->gradient[k] : nan;
+                }
+            }
+            if (out.hessian) {
+                double* h = &out.hessian[i];
+                for (int a = 0, k = 0; a < kSensitivityCount; ++a) {
+                    for (int b = a; b < kSensitivityCount; ++b, ++k) {
+                        h[k] = s ? s->hessian[a][b] : nan;
+                    }
+                }
+            }
+            if (out.status) {
+                out.status[i] = static_cast<std::int32_t>(status);
+            }
+            return status;
+        };
+
+        return detail::for_each_row(in.count, threads, [&](std::size_t i) {
+            bool call = in.call ? in.call[i] != 0 : true;
+            double S = in.S[i], K = in.K[i], T = in.T[i], r = in.r[i], sigma = in.sigma[i];
+            double q = in.q ? in.q[i] : 0.0;
+            if (!inputs_valid(S, K, T, r, sigma, q)) {
+                return finish(i, nullptr, BatchStatus::InvalidInput);
+            }
+            PriceSensitivities s;
+            evaluate(call, S, K, T, r, sigma, q, s);
+            return finish(i, &s, BatchStatus::Ok);
+        }, [&](std::size_t i) { finish(i, nullptr, BatchStatus::Error); });
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include "batch/batch.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace GreeksCalculator {
+    // Variables of the price gradient and Hessian, in index order. T is time to expiry.
+    enum class SensitivityVariable : int { S, Sigma, R, Q, T, Count };
+
+    constexpr int kSensitivityCount = static_cast<int>(SensitivityVariable::Count);
+    constexpr int kPackedHessianSize = kSensitivityCount * (kSensitivityCount + 1) / 2;
+
+    // Position of H[i][j] in a packed upper triangle stored row by row:
+    // (S,S) (S,sigma) (S,r) (S,q) (S,T) (sigma,sigma) ... (T,T).
+    constexpr int packed_hessian_index(int i, int j) {
+        return i <= j ? i * kSensitivityCount - i * (i - 1) / 2 + (j - i) : packed_hessian_index(j, i);
+    }
+
+    // Raw (unscaled) BSM price, gradient and Hessian in (S, sigma, r, q, T). Under
+    // ScalingParams::no_scaling() the entries are the named Greeks:
+    //   gradient = (delta, vega, rho, epsilon, -theta)
+    //   H[S][S] = gamma, H[S][sigma] = vanna, H[S][T] = -charm,
+    //   H[sigma][sigma] = volga, H[sigma][r] = vera, H[sigma][T] = -veta.
+    // dual_rho is not an entry: it is not a second derivative of the price.
+    struct PriceSensitivities {
+        double price;
+        double gradient[kSensitivityCount];
+        double hessian[kSensitivityCount][kSensitivityCount];  // Symmetric
+    };
+
+    // One fused evaluation (one log, one sqrt, two exponentials, one density and two
+    // normal CDFs). Throws std::invalid_argument on invalid inputs.
+    PriceSensitivities price_sensitivities(bool call, double S, double K, double T, double r, double sigma, double q = 0.0);
+
+    // Row i's gradient occupies gradient[i] .. gradient[i] + 4 and its packed Hessian
+    // hessian[i] .. hessian[i] + 14, so the views' strides are in elements between rows
+    // (at least 5 and 15; the defaults pack rows back to back). Every output is optional.
+    struct SensitivityOutputs {
+        StridedView<double> price;
+        StridedView<double> gradient{nullptr, kSensitivityCount};
+        StridedView<double> hessian{nullptr, kPackedHessianSize};
+        StridedView<std::int32_t> status;
+    };
+
+    // Batch price_sensitivities with the batch_greeks threading and status handling:
+    // invalid rows get NaN outputs and BatchStatus::InvalidInput. Returns the number of
+    // rows that were not Ok. Throws std::invalid_argument if a gradient or Hessian view
+    // is set with a stride below 5 or 15.
+    std::size_t batch_price_sensitivities(const BatchInputs& in, const SensitivityOutputs& out, int threads = 0);
+}
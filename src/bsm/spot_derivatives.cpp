@@ -0,0 +1,112 @@
+#include "bsm/spot_derivatives.h"
+#include "math/cdf.h"
+#include "math/pdf.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    void spot_derivatives(bool call, double S, double K, double T, double r, double sigma, double q, int order,
+                          double* spot, double* vol, double* time, int first) {
+        if (order < 0 || order > kMaxSpotOrder || spot == nullptr) {
+            throw std::invalid_argument("Spot derivative order out of range.");
+        }
+
+        double sqrtT = std::sqrt(T);
+        double v = sigma * sqrtT;
+        double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / v;
+        double d2 = d1 - v;
+        double dq = std::exp(-q * T);
+        double pdf = normal_pdf(d1);
+        // Total derivatives of d1 with respect to T and of d1 with respect to v at fixed log-forward.
+        double dd1_dT = (r - q) / v - d2 / (2.0 * T);
+        double dd1_dv = -d2 / v;
+        double dv_dT = v / (2.0 * T);
+
+        double cdf1 = first <= 1 ? normal_cdf(d1) : 0.0;
+        if (first <= 0) {
+            double Kr = K * std::exp(-r * T);
+            double cdf2 = normal_cdf(d2);
+            spot[0] = call ? S * dq * cdf1 - Kr * cdf2 : Kr * (1.0 - cdf2) - S * dq * (1.0 - cdf1);
+            if (vol) {
+                vol[0] = S * dq * pdf * sqrtT;
+            }
+            if (time) {
+                double decay = S * dq * pdf * sigma / (2.0 * sqrtT);
+                time[0] = call ? decay - q * S * dq * cdf1 + r * Kr * cdf2
+                               : decay + q * S * dq * (1.0 - cdf1) - r * Kr * (1.0 - cdf2);
+            }
+        }
+        if (order == 0) {
+            return;
+        }
+
+        if (first <= 1) {
+            double N1 = call ? cdf1 : cdf1 - 1.0;
+            spot[1] = dq * N1;
+            if (vol) {
+                vol[1] = dq * pdf * dd1_dv * sqrtT;
+            }
+            if (time) {
+                time[1] = dq * (pdf * dd1_dT - q * N1);
+            }
+        }
+
+        // a holds Q_n and b holds dQ_n/dv (at fixed d1), both as coefficients of powers of d1.
+        double a[kMaxSpotOrder + 1] = {1.0 / v};
+        double b[kMaxSpotOrder + 1] = {-1.0 / (v * v)};
+        double scale = dq * pdf;
+        const bool cross = vol || time;
+        for (int n = 2; n <= order; ++n) {
+            scale /= S;
+            if (n > 2) {
+                // Q_n from Q_(n-1), which has degree n - 3.
+                int m = n - 3;
+                double na[kMaxSpotOrder + 1], nb[kMaxSpotOrder + 1];
+                for (int i = 0; i <= m + 1; ++i) {
+                    double da = (i + 1 <= m ? (i + 1) * a[i + 1] : 0.0) - (i >= 1 ? a[i - 1] : 0.0);
+                    double ai = i <= m ? a[i] : 0.0;
+                    na[i] = da / v - (n - 2) * ai;
+                    if (cross) {
+                        double db = (i + 1 <= m ? (i + 1) * b[i + 1] : 0.0) - (i >= 1 ? b[i - 1] : 0.0);
+                        double bi = i <= m ? b[i] : 0.0;
+                        nb[i] = db / v - da / (v * v) - (n - 2) * bi;
+                    }
+                }
+                for (int i = 0; i <= m + 1; ++i) {
+                    a[i] = na[i];
+                    if (cross) {
+                        b[i] = nb[i];
+                    }
+                }
+            }
+
+            if (n < first) {
+                continue;
+            }
+
+            // Horner evaluation of Q, dQ/dd1 and dQ/dv at d1.
+            int deg = n - 2;
+            double Q = a[deg], dQ = 0.0, R = b[deg];
+            for (int i = deg - 1; i >= 0; --i) {
+                dQ = dQ * d1 + Q;
+                Q = Q * d1 + a[i];
+                R = R * d1 + b[i];
+            }
+
+            spot[n] = scale * Q;
+            double slope = dQ - d1 * Q;   // d(phi * Q)/dd1 over phi
+            if (vol) {
+                vol[n] = scale * (slope * dd1_dv + R) * sqrtT;
+            }
+            if (time) {
+                time[n] = scale * (slope * dd1_dT + R * dv_dT - q * Q);
+            }
+        }
+    }
+
+    double spot_derivative(bool call, double S, double K, double T, double r, double sigma, double q, int n) {
+        double spot[kMaxSpotOrder + 1];
+        spot_derivatives(call, S, K, T, r, sigma, q, n, spot, nullptr, nullptr, n);
+        return spot[n];
+    }
+}
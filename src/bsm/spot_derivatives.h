@@ -0,0 +1,30 @@
+#pragma once
+
+namespace GreeksCalculator {
+    constexpr int kMaxSpotOrder = 24;
+
+    // Raw (unscaled) BSM spot derivatives up to `order` in one pass:
+    //   spot[n] = d^n V / dS^n                   (spot[0] is the price)
+    //   vol[n]  = d^(n+1) V / dS^n dsigma        (vol[0] is vega, vol[1] vanna, vol[2] zomma)
+    //   time[n] = d^(n+1) V / dS^n dT            (T is time to expiry, so charm = -time[1])
+    // Each array must hold order + 1 values; vol and time may be null. For n >= 2 all three
+    // are exp(-qT) * phi(d1) * Q_n(d1) / S^(n-1) with Q_n a Hermite-type polynomial in d1:
+    //   Q_2 = 1 / v,  Q_(n+1) = (Q_n' - d1 * Q_n) / v - (n - 1) * Q_n,  v = sigma * sqrt(T)
+    // so order n costs O(n). Entries below `first` are left untouched, and first >= 2 skips
+    // the CDF and discounting work of the price and delta terms.
+    // Throws std::invalid_argument for order outside [0, kMaxSpotOrder].
+    void spot_derivatives(bool call, double S, double K, double T, double r, double sigma, double q, int order,
+                          double* spot, double* vol = nullptr, double* time = nullptr, int first = 0);
+
+    // Single n-th spot derivative (n >= 0).
+    double spot_derivative(bool call, double S, double K, double T, double r, double sigma, double q, int n);
+
+    namespace detail {
+        // Greeks that scale a spot derivative by a polynomial in d1 and v = sigma sqrt(T),
+        // so calculate_all can feed them from its single recurrence pass.
+        double crackle_from_snap(double snap, double S, double d1, double v);
+        double pop_from_snap(double snap, double S, double d1, double v);
+        double quintema_from_jounce(double jounce, double S, double d1, double v);
+        double hexema_from_pounce(double pounce, double S, double d1, double v);
+    }
+}
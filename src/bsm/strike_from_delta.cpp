@@ -0,0 +1,149 @@
+#include "bsm/strike_from_delta.h"
+#include "bsm/validation.h"
+#include "math/cdf.h"
+#include "math/common.h"
+#include "math/d1.h"
+#include "math/pdf.h"
+#include <algorithm>
+
+namespace GreeksCalculator {
+    namespace {
+        bool premium_adjusted(DeltaConvention convention) {
+            return convention == DeltaConvention::SpotPremiumAdjusted || convention == DeltaConvention::ForwardPremiumAdjusted;
+        }
+
+        bool spot_based(DeltaConvention convention) {
+            return convention == DeltaConvention::Spot || convention == DeltaConvention::SpotPremiumAdjusted;
+        }
+
+        // Where a premium-adjusted call delta exp(-v x - v^2 / 2) N(x) peaks as a function of
+        // x = d2: phi(x) / N(x) = v. The ratio falls monotonically in x, so bisect on it.
+        double premium_adjusted_peak(double v) {
+            double lo = -40.0, hi = 40.0;
+            for (int i = 0; i < 200 && hi - lo > 1e-15 * (1.0 + std::abs(lo)); ++i) {
+                double mid = 0.5 * (lo + hi);
+                if (normal_pdf(mid) > v * normal_cdf(mid)) {
+                    lo = mid;
+                } else {
+                    hi = mid;
+                }
+            }
+            return 0.5 * (lo + hi);
+        }
+
+        // Solves w (K / F) N(w x) = target for x = d2, where K / F = exp(-v x - v^2 / 2).
+        // In log form f(x) = -v x - v^2 / 2 + log N(w x) - log target, which is decreasing for
+        // puts everywhere and increasing for calls below the peak. Newton steps that leave
+        // the bracket are replaced by bisection.
+        double premium_adjusted_d2(bool call, double target, double v, double guess) {
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            double w = call ? 1.0 : -1.0;
+            double log_target = std::log(target);
+            auto f = [&](double x, double& slope) {
+                double N = normal_cdf(w * x);
+                slope = -v + w * normal_pdf(x) / N;
+                return -v * x - 0.5 * v * v + std::log(N) - log_target;
+            };
+
+            // Bracket [lo, hi] with f(lo) and f(hi) of opposite signs (calls: f(lo) < 0 < f(hi)).
+            double slope = 0.0;
+            double lo, hi;
+            if (call) {
+                hi = premium_adjusted_peak(v);
+                if (f(hi, slope) < 0.0) {
+                    return nan;     // Beyond the largest attainable delta
+                }
+                lo = std::min(guess, hi) - 1.0;
+                for (double step = 1.0; f(lo, slope) > 0.0; step *= 2.0) {
+                    if (step > 1e6) {
+                        return nan;
+                    }
+                    lo -= step;
+                }
+            } else {
+                lo = guess - 1.0;
+                hi = guess + 1.0;
+                for (double step = 1.0; f(lo, slope) < 0.0; step *= 2.0) {
+                    if (step > 1e6) {
+                        return nan;
+                    }
+                    lo -= step;
+                }
+                for (double step = 1.0; f(hi, slope) > 0.0; step *= 2.0) {
+                    if (step > 1e6) {
+                        return nan;
+                    }
+                    hi += step;
+                }
+            }
+
+            double x = std::min(std::max(guess, lo), hi);
+            for (int i = 0; i < 100; ++i) {
+                double value = f(x, slope);
+                if (std::abs(value) <= 1e-15) {
+                    return x;
+                }
+                // f increases in x for calls and decreases for puts.
+                if ((value < 0.0) == call) {
+                    lo = x;
+                } else {
+                    hi = x;
+                }
+                double next = slope != 0.0 ? x - value / slope : nan;
+                if (!(next > lo && next < hi)) {
+                    next = 0.5 * (lo + hi);
+                }
+                if (std::abs(next - x) <= 1e-15 * (1.0 + std::abs(x))) {
+                    return next;
+                }
+                x = next;
+            }
+            return nan;
+        }
+    }
+
+    double convention_delta(bool call, double S, double K, double T, double r, double sigma, double q,
+                            DeltaConvention convention) {
+        double w = call ? 1.0 : -1.0;
+        double d1 = calculate_d1(S, K, T, r, sigma, q);
+        double scale = spot_based(convention) ? exp_dividend(q, T) : 1.0;
+        if (premium_adjusted(convention)) {
+            double F = S * std::exp((r - q) * T);
+            return scale * w * (K / F) * normal_cdf(w * (d1 - sigma * std::sqrt(T)));
+        }
+        return scale * w * normal_cdf(w * d1);
+    }
+
+    double strike_from_delta(bool call, double delta, double S, double T, double r, double sigma, double q,
+                             DeltaConvention convention) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        double w = call ? 1.0 : -1.0;
+        if (!inputs_valid(S, S, T, r, sigma, q) || !(w * delta > 0.0)) {
+            return nan;
+        }
+        double F = S * std::exp((r - q) * T);
+        double v = sigma * std::sqrt(T);
+        // Undo the exp(-qT) factor of the spot conventions to work in forward terms.
+        double target = w * delta / (spot_based(convention) ? exp_dividend(q, T) : 1.0);
+
+        if (premium_adjusted(convention)) {
+            // The unadjusted strike's d2 starts the solve.
+            double guess = target < 1.0 ? w * inverse_normal_cdf(target) - v : 0.0;
+            double x = premium_adjusted_d2(call, target, v, guess);
+            return F * std::exp(-v * x - 0.5 * v * v);
+        }
+        if (!(target < 1.0)) {
+            return nan;
+        }
+        double d1 = w * inverse_normal_cdf(target);
+        return F * std::exp(0.5 * v * v - v * d1);
+    }
+
+    std::size_t batch_strike_from_delta(const DeltaStrikeInputs& in, StridedView<double> out_strike,
+                                        StridedView<std::int32_t> status, DeltaConvention convention, int threads) {
+        return detail::for_each_strike(in, out_strike, status, threads,
+                                       [&](std::size_t i, bool call, double delta, double S, double T, double r, double q) {
+            return strike_from_delta(call, delta, S, T, r, in.sigma[i], q, convention);
+        });
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "batch/batch.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace GreeksCalculator {
+    // Delta quoting conventions. Spot delta is calculate_delta; forward delta drops the
+    // exp(-qT) factor. Premium-adjusted deltas (premium paid in the underlying, as for most
+    // FX pairs) subtract price / S, which makes them w * (K / F) * N(w * d2) times the same
+    // factor, with w = +1 for calls and -1 for puts.
+    enum class DeltaConvention {
+        Spot,
+        Forward,
+        SpotPremiumAdjusted,
+        ForwardPremiumAdjusted,
+    };
+
+    // Delta of the option at strike K under `convention` (signed like calculate_delta).
+    double convention_delta(bool call, double S, double K, double T, double r, double sigma, double q,
+                            DeltaConvention convention);
+
+    // Strike whose delta under `convention` equals `delta` at volatility sigma. Closed form
+    // for the unadjusted conventions; premium-adjusted deltas are solved by safeguarded
+    // Newton in d2. A premium-adjusted call delta peaks at a finite strike, and the strike
+    // above that peak is returned. NaN if the delta is unattainable (wrong sign, beyond
+    // the maximum) or the inputs are invalid.
+    double strike_from_delta(bool call, double delta, double S, double T, double r, double sigma, double q = 0.0,
+                             DeltaConvention convention = DeltaConvention::Spot);
+
+    // Strike from delta on a smile: `vol(K)` gives the volatility at strike K for this expiry.
+    // Iterates K -> strike_from_delta(..., vol(K)) from the at-the-money-forward volatility,
+    // which converges for any smile whose delta stays monotonic in K. NaN if it does not
+    // converge in `max_iter` steps.
+    template <typename VolFn>
+    double strike_from_delta(bool call, double delta, double S, double T, double r, double q, DeltaConvention convention,
+                             VolFn&& vol, int max_iter = 50) {
+        double K = S * std::exp((r - q) * T);
+        for (int i = 0; i < max_iter; ++i) {
+            double next = strike_from_delta(call, delta, S, T, r, vol(K), q, convention);
+            if (!std::isfinite(next)) {
+                return std::numeric_limits<double>::quiet_NaN();
+            }
+            if (std::abs(next - K) <= 1e-13 * K) {
+                return next;
+            }
+            K = next;
+        }
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    struct DeltaStrikeInputs {
+        std::size_t count = 0;
+        StridedView<const std::uint8_t> call;   // Non-zero for calls; null means every row is a call
+        StridedView<const double> delta;
+        StridedView<const double> S;
+        StridedView<const double> T;
+        StridedView<const double> r;
+        StridedView<const double> sigma;        // Ignored by the smile overload
+        StridedView<const double> q;            // Optional; null means zero dividend yield
+    };
+
+    namespace detail {
+        template <typename Strike>
+        std::size_t for_each_strike(const DeltaStrikeInputs& in, StridedView<double> out_strike,
+                                    StridedView<std::int32_t> status, int threads, Strike strike) {
+            return for_each_row(in.count, threads, [&](std::size_t i) {
+                bool call = in.call ? in.call[i] != 0 : true;
+                double q = in.q ? in.q[i] : 0.0;
+                double K = strike(i, call, in.delta[i], in.S[i], in.T[i], in.r[i], q);
+                BatchStatus s = std::isfinite(K) ? BatchStatus::Ok : BatchStatus::InvalidInput;
+                out_strike[i] = K;
+                if (status) {
+                    status[i] = static_cast<std::int32_t>(s);
+                }
+                return s;
+            }, [&](std::size_t i) {
+                out_strike[i] = std::numeric_limits<double>::quiet_NaN();
+                if (status) {
+                    status[i] = static_cast<std::int32_t>(BatchStatus::Error);
+                }
+            });
+        }
+    }
+
+    // Batch strike_from_delta with each row's own volatility. Rows whose delta cannot be
+    // reached get NaN and BatchStatus::InvalidInput. Returns the number of rows not Ok.
+    std::size_t batch_strike_from_delta(const DeltaStrikeInputs& in, StridedView<double> out_strike,
+                                        StridedView<std::int32_t> status = {},
+                                        DeltaConvention convention = DeltaConvention::Spot, int threads = 0);
+
+    // Smile version: `vol(K, T)` gives the volatility at strike K and expiry T, e.g.
+    // [&](double K, double T) { return surface.volatility(K, T); } for an SviSurface.
+    template <typename VolFn>
+    std::size_t batch_strike_from_delta(const DeltaStrikeInputs& in, VolFn&& vol, StridedView<double> out_strike,
+                                        StridedView<std::int32_t> status = {},
+                                        DeltaConvention convention = DeltaConvention::Spot, int threads = 0) {
+        return detail::for_each_strike(in, out_strike, status, threads,
+                                       [&](std::size_t, bool call, double delta, double S, double T, double r, double q) {
+            return strike_from_delta(call, delta, S, T, r, q, convention, [&](double K) { return vol(K, T); });
+        });
+    }
+}
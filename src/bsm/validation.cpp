@@ -1,10 +1,17 @@
 #include "bsm/validation.h"
+#include <cmath>
 #include <stdexcept>
 
 namespace GreeksCalculator {
+    bool inputs_valid(double S, double K, double T, double r, double sigma, double q) {
+        return S > 0.0 && K > 0.0 && T > 0.0 && sigma > 0.0 &&
+               std::isfinite(S) && std::isfinite(K) && std::isfinite(T) && std::isfinite(sigma) &&
+               std::isfinite(r) && std::isfinite(q);
+    }
+
     void validate_inputs(double S, double K, double T, double r, double sigma, double q) {
         if (S <= 0.0 || K <= 0.0 || T <= 0.0 || sigma <= 0.0) {
             throw std::invalid_argument("Invalid Black-Scholes-Merton parameters: S, K, T, and sigma must be positive.");
         }
     }
-}
\ No newline at end of file
+}
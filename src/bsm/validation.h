@@ -1,5 +1,7 @@
 #pragma once
 
 namespace GreeksCalculator {
+    // Non-throwing check used by the batch entry points; validate_inputs throws on the same condition.
+    bool inputs_valid(double S, double K, double T, double r, double sigma, double q);
     void validate_inputs(double S, double K, double T, double r, double sigma, double q);
-}
\ No newline at end of file
+}
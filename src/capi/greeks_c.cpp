@@ -0,0 +1,145 @@
+#include "capi/greeks_c.h"
+#include "batch/batch.h"
+#include "models/models.h"
+
+using namespace GreeksCalculator;
+
+namespace {
+    template <typename T>
+    StridedView<T> view(T* data, int64_t stride) {
+        return {data, static_cast<std::ptrdiff_t>(stride)};
+    }
+
+    template <typename T>
+    StridedView<T> output_view(T* data, int64_t stride) {
+        return {data, static_cast<std::ptrdiff_t>(stride == 0 ? 1 : stride)};
+    }
+
+    bool convert_inputs(const oqg_inputs* in, bool need_vol, BatchInputs& out) {
+        if (!in || !in->spot || !in->strike || !in->expiry || !in->rate || (need_vol && !in->vol)) {
+            return false;
+        }
+        out.count = in->count;
+        out.call = view(in->is_call, in->is_call_stride);
+        out.S = view(in->spot, in->spot_stride);
+        out.K = view(in->strike, in->strike_stride);
+        out.T = view(in->expiry, in->expiry_stride);
+        out.r = view(in->rate, in->rate_stride);
+        out.sigma = view(in->vol, in->vol_stride);
+        out.q = view(in->dividend, in->dividend_stride);
+        return true;
+    }
+
+    int32_t result_code(std::size_t failures) {
+        return failures == 0 ? OQG_OK : OQG_PARTIAL;
+    }
+
+    bool convert_outputs(const oqg_outputs* outputs, BatchOutputs& out) {
+        if (!outputs || (outputs->columns & ~kAllGreeks) != 0) {
+            return false;
+        }
+        out.columns = outputs->columns;
+        for (int c = 0; c < kGreekColumnCount; ++c) {
+            if (out.columns & greek_bit(static_cast<GreekColumn>(c))) {
+                if (!outputs->data[c]) {
+                    return false;
+                }
+                out.greeks[c] = output_view(outputs->data[c], outputs->stride[c]);
+            }
+        }
+        out.status = output_view(outputs->status, outputs->status_stride);
+        return true;
+    }
+
+    ScalingParams convert_scaling(const oqg_scaling* scaling) {
+        if (!scaling) {
+            return ScalingParams::standard();
+        }
+        return {scaling->vega_scale, scaling->rho_scale, scaling->epsilon_scale,
+                scaling->theta_scale, scaling->charm_scale, scaling->color_scale};
+    }
+}
+
+static_assert(OQG_COLUMN_COUNT == kGreekColumnCount, "C column enum out of sync with GreekColumn");
+
+extern "C" {
+    int32_t oqg_abi_version(void) {
+        return OQG_ABI_VERSION;
+    }
+
+    const char* oqg_column_name(int32_t column) {
+        return greek_name(static_cast<GreekColumn>(column));
+    }
+
+    int32_t oqg_greeks(const oqg_inputs* inputs, const oqg_outputs* outputs, const oqg_scaling* scaling, int32_t threads) {
+        try {
+            BatchInputs in;
+            BatchOutputs out;
+            if (!convert_inputs(inputs, true, in) || !convert_outputs(outputs, out)) {
+                return OQG_ERROR_ARGUMENT;
+            }
+            return result_code(batch_greeks(in, out, convert_scaling(scaling), threads));
+        } catch (...) {
+            return OQG_ERROR_INTERNAL;
+        }
+    }
+
+    int32_t oqg_implied_volatility(const oqg_inputs* inputs, const double* price, int64_t price_stride,
+                                   double* vol_out, int64_t vol_out_stride, int32_t* status, int64_t status_stride,
+                                   int32_t threads) {
+        try {
+            BatchInputs in;
+            if (!convert_inputs(inputs, false, in) || !price || !vol_out) {
+                return OQG_ERROR_ARGUMENT;
+            }
+            return result_code(batch_implied_volatility(in, view(price, price_stride), output_view(vol_out, vol_out_stride),
+                                                        output_view(status, status_stride), threads));
+        } catch (...) {
+            return OQG_ERROR_INTERNAL;
+        }
+    }
+
+    int32_t oqg_model_greeks(int32_t model, const oqg_inputs* inputs, const oqg_outputs* outputs, const oqg_scaling* scaling,
+                             int32_t threads) {
+        try {
+            BatchInputs in;
+            BatchOutputs out;
+            if (!convert_inputs(inputs, true, in) || !convert_outputs(outputs, out)) {
+                return OQG_ERROR_ARGUMENT;
+            }
+            ScalingParams params = convert_scaling(scaling);
+            switch (model) {
+                case OQG_MODEL_BSM: return result_code(batch_greeks(in, out, params, threads));
+                case OQG_MODEL_BLACK76: return result_code(model_batch_greeks<Black76Model>(in, out, params, threads));
+                case OQG_MODEL_BACHELIER: return result_code(model_batch_greeks<BachelierModel>(in, out, params, threads));
+                default: return OQG_ERROR_ARGUMENT;
+            }
+        } catch (...) {
+            return OQG_ERROR_INTERNAL;
+        }
+    }
+
+    int32_t oqg_model_implied_volatility(int32_t model, const oqg_inputs* inputs, const double* price, int64_t price_stride,
+                                         double* vol_out, int64_t vol_out_stride, int32_t* status, int64_t status_stride,
+                                         int32_t threads) {
+        try {
+            BatchInputs in;
+            if (!convert_inputs(inputs, false, in) || !price || !vol_out) {
+                return OQG_ERROR_ARGUMENT;
+            }
+            auto prices = view(price, price_stride);
+            auto vols = output_view(vol_out, vol_out_stride);
+            auto statuses = output_view(status, status_stride);
+            switch (model) {
+                case OQG_MODEL_BSM: return result_code(batch_implied_volatility(in, prices, vols, statuses, threads));
+                case OQG_MODEL_BLACK76:
+                    return result_code(model_batch_implied_volatility<Black76Model>(in, prices, vols, statuses, threads));
+                case OQG_MODEL_BACHELIER:
+                    return result_code(model_batch_implied_volatility<BachelierModel>(in, prices, vols, statuses, threads));
+                default: return OQG_ERROR_ARGUMENT;
+            }
+        } catch (...) {
+            return OQG_ERROR_INTERNAL;
+        }
+    }
+}
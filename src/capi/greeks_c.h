@@ -0,0 +1,125 @@
+/*
+ * Stable C ABI for OpenQuantGreeks.
+ *
+ * All entry points operate on caller-owned arrays and never throw. Strides are
+ * in elements, so a numpy array `a` is passed as (a.ctypes.data, a.strides[0] // a.itemsize).
+ * An input stride of 0 broadcasts element 0 to every row. Structs only ever grow
+ * at the end; check oqg_abi_version() before relying on newer fields.
+ */
+#ifndef OPENQUANTGREEKS_GREEKS_C_H
+#define OPENQUANTGREEKS_GREEKS_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(_WIN32)
+#  if defined(OQG_BUILDING_LIBRARY)
+#    define OQG_API __declspec(dllexport)
+#  else
+#    define OQG_API __declspec(dllimport)
+#  endif
+#else
+#  define OQG_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define OQG_ABI_VERSION 2
+
+/* Output columns, one per field of the C++ `Greeks` struct and in the same order. */
+enum oqg_column {
+    OQG_PRICE, OQG_DELTA, OQG_VEGA, OQG_THETA, OQG_RHO, OQG_LAMBDA, OQG_EPSILON,
+    OQG_GAMMA, OQG_VANNA, OQG_CHARM, OQG_VOLGA, OQG_VETA, OQG_VERA, OQG_DUAL_RHO,
+    OQG_SPEED, OQG_ZOMMA, OQG_COLOR, OQG_ULTIMA, OQG_DVANNA_DVOL,
+    OQG_SNAP, OQG_ZED_ZETA, OQG_CRACKLE, OQG_POP,
+    OQG_JOUNCE, OQG_QUINTEMA, OQG_MIXED5TH,
+    OQG_POUNCE, OQG_HEXEMA, OQG_MIXED6TH,
+    OQG_COLUMN_COUNT
+};
+
+#define OQG_COLUMN_BIT(column) (UINT64_C(1) << (column))
+
+/* Pricing models (ABI version 2). For Black-76 and Bachelier the spot column carries
+ * the forward, the dividend column is ignored, and Bachelier volatilities are absolute. */
+enum oqg_model {
+    OQG_MODEL_BSM = 0,
+    OQG_MODEL_BLACK76 = 1,
+    OQG_MODEL_BACHELIER = 2
+};
+
+/* Return codes of the batch functions. */
+enum oqg_result {
+    OQG_OK = 0,                 /* Every row succeeded */
+    OQG_PARTIAL = 1,            /* Some rows failed; see the status array */
+    OQG_ERROR_ARGUMENT = -1,    /* Missing pointer or unknown column; nothing was written */
+    OQG_ERROR_INTERNAL = -2
+};
+
+/* Per-row status codes. */
+enum oqg_status {
+    OQG_STATUS_OK = 0,
+    OQG_STATUS_INVALID_INPUT = 1,
+    OQG_STATUS_NO_CONVERGENCE = 2,
+    OQG_STATUS_ERROR = 3
+};
+
+typedef struct oqg_inputs {
+    size_t count;
+    const uint8_t* is_call;  int64_t is_call_stride;    /* NULL: all calls */
+    const double* spot;      int64_t spot_stride;
+    const double* strike;    int64_t strike_stride;
+    const double* expiry;    int64_t expiry_stride;     /* Years */
+    const double* rate;      int64_t rate_stride;
+    const double* vol;       int64_t vol_stride;        /* Ignored by oqg_implied_volatility */
+    const double* dividend;  int64_t dividend_stride;   /* NULL: zero yield */
+} oqg_inputs;
+
+typedef struct oqg_outputs {
+    uint64_t columns;                          /* OR of OQG_COLUMN_BIT(...) */
+    double* data[OQG_COLUMN_COUNT];            /* Only requested columns are read */
+    int64_t stride[OQG_COLUMN_COUNT];          /* 0 is treated as 1 (contiguous) */
+    int32_t* status;  int64_t status_stride;   /* Optional oqg_status per row */
+} oqg_outputs;
+
+/* Mirrors ScalingParams; pass NULL for the library default (ScalingParams::standard()). */
+typedef struct oqg_scaling {
+    double vega_scale;
+    double rho_scale;
+    double epsilon_scale;
+    double theta_scale;
+    double charm_scale;
+    double color_scale;
+} oqg_scaling;
+
+OQG_API int32_t oqg_abi_version(void);
+OQG_API const char* oqg_column_name(int32_t column);
+
+/* Computes the requested Greek columns. threads <= 0 uses every core. */
+OQG_API int32_t oqg_greeks(const oqg_inputs* inputs, const oqg_outputs* outputs,
+                           const oqg_scaling* scaling, int32_t threads);
+
+/* Solves for the Black-Scholes-Merton implied volatility of each row. */
+OQG_API int32_t oqg_implied_volatility(const oqg_inputs* inputs,
+                                       const double* price, int64_t price_stride,
+                                       double* vol_out, int64_t vol_out_stride,
+                                       int32_t* status, int64_t status_stride,
+                                       int32_t threads);
+
+/* oqg_greeks and oqg_implied_volatility for any oqg_model (ABI version 2). Columns a
+ * model does not define are written as NaN; an unknown model is OQG_ERROR_ARGUMENT. */
+OQG_API int32_t oqg_model_greeks(int32_t model, const oqg_inputs* inputs, const oqg_outputs* outputs,
+                                 const oqg_scaling* scaling, int32_t threads);
+
+OQG_API int32_t oqg_model_implied_volatility(int32_t model, const oqg_inputs* inputs,
+                                             const double* price, int64_t price_stride,
+                                             double* vol_out, int64_t vol_out_stride,
+                                             int32_t* status, int64_t status_stride,
+                                             int32_t threads);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,282 @@
+#include "hedge/simulator.h"
+#include "math/cdf.h"
+#include "math/pdf.h"
+#include "math/philox.h"
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace GreeksCalculator {
+    namespace {
+        // Paths per parallel task; results land in per-path slots, so the split never
+        // changes the report.
+        constexpr std::size_t kPathsPerTask = 64;
+
+        // The BSM terms that depend only on the step, shared by every path.
+        struct StepTable {
+            std::vector<double> drift;      // (r - q + sigma^2 / 2) tau
+            std::vector<double> inv_vol;    // 1 / (sigma sqrt(tau))
+            std::vector<double> vol;        // sigma sqrt(tau)
+            std::vector<double> dq, dr;     // exp(-q tau), exp(-r tau)
+            std::vector<double> band;       // Whalley-Wilmott 3 exp(-r tau) cost / (2 risk aversion)
+            double growth = 1.0;            // Cash growth over one step
+            double dividend = 0.0;          // Dividend per unit of spot held over one step
+
+            StepTable(const HedgeOption& o, const HedgePolicy& policy, const HedgeCosts& costs, std::size_t steps) {
+                double dt = o.T / static_cast<double>(steps);
+                drift.resize(steps);
+                inv_vol.resize(steps);
+                vol.resize(steps);
+                dq.resize(steps);
+                dr.resize(steps);
+                band.resize(steps);
+                for (std::size_t k = 0; k < steps; ++k) {
+                    double tau = o.T - dt * static_cast<double>(k);
+                    vol[k] = o.sigma * std::sqrt(tau);
+                    inv_vol[k] = 1.0 / vol[k];
+                    drift[k] = (o.r - o.q + 0.5 * o.sigma * o.sigma) * tau;
+                    dq[k] = std::exp(-o.q * tau);
+                    dr[k] = std::exp(-o.r * tau);
+                    band[k] = 1.5 * dr[k] * costs.proportional / policy.risk_aversion;
+                }
+                growth = std::exp(o.r * dt);
+                dividend = o.q * dt;
+            }
+        };
+
+        struct Mark {
+            double value, delta, gamma;
+        };
+
+        Mark mark(const HedgeOption& o, const StepTable& t, std::size_t k, double S, bool need_gamma) {
+            double d1 = (std::log(S / o.K) + t.drift[k]) * t.inv_vol[k];
+            double d2 = d1 - t.vol[k];
+            Mark m;
+            if (o.call) {
+                double N1 = normal_cdf(d1);
+                m.value = S * t.dq[k] * N1 - o.K * t.dr[k] * normal_cdf(d2);
+                m.delta = t.dq[k] * N1;
+            } else {
+                double N1 = normal_cdf(-d1);
+                m.value = o.K * t.dr[k] * normal_cdf(-d2) - S * t.dq[k] * N1;
+                m.delta = -t.dq[k] * N1;
+            }
+            m.gamma = need_gamma ? t.dq[k] * normal_pdf(d1) * t.inv_vol[k] / S : 0.0;
+            return m;
+        }
+
+        // Runs one path. `next(k)` returns the spot at step k + 1.
+        template <typename Next>
+        HedgePathResult hedge_path(const HedgeOption& o, const HedgePolicy& policy, const HedgeCosts& costs,
+                                   const StepTable& table, std::size_t steps, double S, Next next) {
+            const bool need_gamma = policy.kind == HedgePolicyKind::Gamma;
+            const double size = std::abs(o.quantity);
+            HedgePathResult result;
+            double shares = 0.0;
+            Mark m = mark(o, table, 0, S, need_gamma);
+            double cash = -o.quantity * m.value;    // Premium received for sold options
+            double sum_sq = 0.0;
+
+            for (std::size_t k = 0;; ++k) {
+                double centre = -o.quantity * m.delta;
+                double target = shares;
+                switch (policy.kind) {
+                    case HedgePolicyKind::Time:
+                        if (k % policy.interval == 0) {
+                            target = centre;
+                        }
+                        break;
+                    case HedgePolicyKind::Band:
+                        if (k == 0 || std::abs(shares - centre) > policy.band * size) {
+                            target = centre;
+                        }
+                        break;
+                    case HedgePolicyKind::Gamma: {
+                        double position_gamma = size * m.gamma;
+                        double half = std::cbrt(table.band[k] * S * position_gamma * position_gamma);
+                        target = std::min(std::max(shares, centre - half), centre + half);
+                        break;
+                    }
+                }
+                if (target != shares) {
+                    double traded = target - shares;
+                    double fee = costs.proportional * std::abs(traded) * S + costs.per_trade;
+                    cash -= traded * S + fee;
+                    result.cost += fee;
+                    ++result.trades;
+                    shares = target;
+                }
+
+                double before = o.quantity * m.value + shares * S + cash;
+                cash = cash * table.growth + shares * S * table.dividend;
+                S = next(k);
+                if (k + 1 == steps) {
+                    double payoff = std::max(o.call ? S - o.K : o.K - S, 0.0);
+                    result.pnl = o.quantity * payoff + shares * S + cash;
+                    double change = result.pnl - before;
+                    result.tracking_error = std::sqrt(sum_sq + change * change);
+                    return result;
+                }
+                m = mark(o, table, k + 1, S, need_gamma);
+                double change = o.quantity * m.value + shares * S + cash - before;
+                sum_sq += change * change;
+            }
+        }
+
+        void validate(const HedgeOption& o, const HedgePolicy& policy, const HedgeCosts& costs) {
+            bool ok = o.K > 0.0 && o.T > 0.0 && o.sigma > 0.0 && std::isfinite(o.K) && std::isfinite(o.T) &&
+                      std::isfinite(o.sigma) && std::isfinite(o.r) && std::isfinite(o.q) && std::isfinite(o.quantity) &&
+                      o.quantity != 0.0 && policy.interval > 0 && policy.band >= 0.0 && policy.risk_aversion > 0.0 &&
+                      costs.proportional >= 0.0 && costs.per_trade >= 0.0;
+            if (!ok) {
+                throw std::invalid_argument("Invalid hedged option, policy or costs.");
+            }
+        }
+
+        HedgeReport summarize(std::vector<HedgePathResult> paths, std::size_t steps) {
+            HedgeReport report;
+            std::vector<double> values(paths.size());
+            auto column = [&](double HedgePathResult::*field) {
+                for (std::size_t i = 0; i < paths.size(); ++i) {
+                    values[i] = paths[i].*field;
+                }
+                return hedge_distribution(values);
+            };
+            report.pnl = column(&HedgePathResult::pnl);
+            report.cost = column(&HedgePathResult::cost);
+            report.tracking_error = column(&HedgePathResult::tracking_error);
+            for (std::size_t i = 0; i < paths.size(); ++i) {
+                values[i] = paths[i].trades;
+            }
+            report.trades = hedge_distribution(values);
+            report.path_steps = static_cast<std::uint64_t>(paths.size()) * steps;
+            report.paths = std::move(paths);
+            return report;
+        }
+    }
+
+    HedgeDistribution hedge_distribution(std::vector<double> values) {
+        HedgeDistribution d;
+        if (values.empty()) {
+            return d;
+        }
+        std::sort(values.begin(), values.end());
+        double n = static_cast<double>(values.size());
+        double sum = 0.0;
+        for (double v : values) {
+            sum += v;
+        }
+        d.mean = sum / n;
+        double sq = 0.0;
+        for (double v : values) {
+            sq += (v - d.mean) * (v - d.mean);
+        }
+        d.std_dev = values.size() > 1 ? std::sqrt(sq / (n - 1.0)) : 0.0;
+        auto percentile = [&](double p) {
+            double x = p * (n - 1.0);
+            std::size_t i = static_cast<std::size_t>(x);
+            if (i + 1 >= values.size()) {
+                return values.back();
+            }
+            return values[i] + (x - static_cast<double>(i)) * (values[i + 1] - values[i]);
+        };
+        d.min = values.front();
+        d.p01 = percentile(0.01);
+        d.p05 = percentile(0.05);
+        d.p50 = percentile(0.5);
+        d.p95 = percentile(0.95);
+        d.p99 = percentile(0.99);
+        d.max = values.back();
+        return d;
+    }
+
+    HedgeReport simulate_hedging(const HedgeOption& option, const HedgePolicy& policy, const HedgeCosts& costs,
+                                 const GbmPathParams& gbm, int threads) {
+        validate(option, policy, costs);
+        if (!(gbm.S0 > 0.0) || !(gbm.sigma >= 0.0) || !std::isfinite(gbm.mu) || !std::isfinite(gbm.S0) ||
+            !std::isfinite(gbm.sigma) || gbm.steps == 0 || gbm.paths > (std::numeric_limits<std::uint32_t>::max)()) {
+            throw std::invalid_argument("Invalid simulated hedging paths.");
+        }
+        const std::size_t steps = gbm.steps;
+        StepTable table(option, policy, costs, steps);
+        const double dt = option.T / static_cast<double>(steps);
+        const double a = (gbm.mu - 0.5 * gbm.sigma * gbm.sigma) * dt, b = gbm.sigma * std::sqrt(dt);
+        const Philox4x32::Key key = Philox4x32::make_key(gbm.seed);
+
+        std::vector<HedgePathResult> results(gbm.paths);
+        parallel_for((gbm.paths + kPathsPerTask - 1) / kPathsPerTask, threads, [&](std::size_t task) {
+            std::vector<double> z(steps);
+            std::size_t end = std::min(gbm.paths, (task + 1) * kPathsPerTask);
+            for (std::size_t i = task * kPathsPerTask; i < end; ++i) {
+                philox_normals(key, static_cast<std::uint32_t>(i), 0, z.data(), steps);
+                double S = gbm.S0;
+                results[i] = hedge_path(option, policy, costs, table, steps, S, [&](std::size_t k) {
+                    S *= std::exp(a + b * z[k]);
+                    return S;
+                });
+            }
+        });
+        return summarize(std::move(results), steps);
+    }
+
+    HedgeReport simulate_hedging(const HedgeOption& option, const HedgePolicy& policy, const HedgeCosts& costs,
+                                 const HedgePaths& paths, int threads) {
+        validate(option, policy, costs);
+        const std::size_t steps = paths.steps, count = paths.count();
+        if (steps == 0 || count == 0 || paths.spots.size() != count * (steps + 1) ||
+            !std::all_of(paths.spots.begin(), paths.spots.end(), [](double s) { return s > 0.0 && std::isfinite(s); })) {
+            throw std::invalid_argument("Hedging paths need at least one step and positive spots.");
+        }
+        StepTable table(option, policy, costs, steps);
+
+        std::vector<HedgePathResult> results(count);
+        parallel_for((count + kPathsPerTask - 1) / kPathsPerTask, threads, [&](std::size_t task) {
+            std::size_t end = std::min(count, (task + 1) * kPathsPerTask);
+            for (std::size_t i = task * kPathsPerTask; i < end; ++i) {
+                const double* spots = paths.path(i);
+                results[i] = hedge_path(option, policy, costs, table, steps, spots[0],
+                                        [spots](std::size_t k) { return spots[k + 1]; });
+            }
+        });
+        return summarize(std::move(results), steps);
+    }
+
+    HedgePaths read_hedge_paths(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Cannot open paths file: " + path);
+        }
+        HedgePaths paths;
+        std::string line, field;
+        std::size_t length = 0;
+        for (std::size_t number = 1; std::getline(file, line); ++number) {
+            if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            std::stringstream fields(line);
+            std::size_t n = 0;
+            try {
+                while (std::getline(fields, field, ',')) {
+                    paths.spots.push_back(std::stod(field));
+                    ++n;
+                }
+            } catch (const std::exception&) {
+                throw std::runtime_error("Malformed spot at " + path + ":" + std::to_string(number));
+            }
+            if (length == 0) {
+                length = n;
+            }
+            if (n != length || n < 2) {
+                throw std::runtime_error("Path at " + path + ":" + std::to_string(number) + " has " + std::to_string(n) +
+                                         " spots; expected " + std::to_string(std::max<std::size_t>(length, 2)));
+            }
+        }
+        paths.steps = length == 0 ? 0 : length - 1;
+        return paths;
+    }
+}
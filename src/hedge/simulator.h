@@ -0,0 +1,105 @@
+#pragma once
+#include "Greeks.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GreeksCalculator {
+    // The hedged position: `quantity` options (negative when sold), priced and hedged with
+    // BSM at the fixed volatility `sigma`, hedged in the underlying until expiry T.
+    struct HedgeOption {
+        bool call = true;
+        double K = 100.0;
+        double T = 1.0;
+        double r = 0.0;
+        double q = 0.0;
+        double sigma = 0.2;
+        double quantity = -1.0;
+    };
+
+    enum class HedgePolicyKind {
+        Time,       // Rehedge to the model delta every `interval` steps
+        Band,       // Rehedge to the model delta when the hedge is off by more than `band` per option
+        Gamma       // Whalley-Wilmott: rehedge to the edge of a band that widens with costs and with
+                    // the position's gamma, so it grows as quantity^(2/3) rather than per option
+    };
+
+    struct HedgePolicy {
+        HedgePolicyKind kind = HedgePolicyKind::Time;
+        std::size_t interval = 1;       // Time: steps between rehedges
+        double band = 0.05;             // Band: delta tolerance per option
+        double risk_aversion = 1.0;     // Gamma: risk aversion of the whole position; lower means wider
+    };
+
+    struct HedgeCosts {
+        double proportional = 0.0;      // Fraction of the traded notional
+        double per_trade = 0.0;         // Fixed charge per rehedge
+    };
+
+    // Geometric Brownian motion paths with real-world drift `mu` and realized volatility
+    // `sigma`, over the option's life in `steps` equal steps. Path i draws its normals
+    // from Philox stream i of `seed`, so a path does not depend on which thread runs it.
+    struct GbmPathParams {
+        double S0 = 100.0;
+        double mu = 0.0;
+        double sigma = 0.2;
+        std::size_t steps = 252;
+        std::size_t paths = 10000;
+        std::uint64_t seed = 0;
+    };
+
+    // Explicit paths, `steps + 1` spots each, evenly spaced over the option's life.
+    struct HedgePaths {
+        std::size_t steps = 0;
+        std::vector<double> spots;      // Path-major
+
+        std::size_t count() const { return steps == 0 ? 0 : spots.size() / (steps + 1); }
+        const double* path(std::size_t i) const { return spots.data() + i * (steps + 1); }
+    };
+
+    struct HedgePathResult {
+        double pnl = 0.0;               // Final value of options, hedge and cash; 0 for a perfect hedge
+        double cost = 0.0;              // Transaction costs paid
+        double tracking_error = 0.0;    // Root sum of squared step changes of the marked portfolio
+        std::uint32_t trades = 0;
+    };
+
+    struct HedgeDistribution {
+        double mean = 0.0;
+        double std_dev = 0.0;
+        double min = 0.0;
+        double p01 = 0.0;
+        double p05 = 0.0;
+        double p50 = 0.0;
+        double p95 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;
+    };
+
+    struct HedgeReport {
+        std::vector<HedgePathResult> paths;     // In path order
+        HedgeDistribution pnl;
+        HedgeDistribution cost;
+        HedgeDistribution tracking_error;
+        HedgeDistribution trades;
+        std::uint64_t path_steps = 0;
+    };
+
+    // Discrete hedging of `option` along every path. Each path carries its own state (spot,
+    // hedge, cash, last mark) from step to step, and the time-dependent BSM terms are
+    // tabulated once per step for all paths, so a path step costs one evaluation of d1.
+    // Paths are split across `threads` workers (0 = all cores); the report does not depend
+    // on the split. Throws std::invalid_argument on an invalid option, policy or path set.
+    HedgeReport simulate_hedging(const HedgeOption& option, const HedgePolicy& policy, const HedgeCosts& costs,
+                                 const GbmPathParams& paths, int threads = 0);
+    HedgeReport simulate_hedging(const HedgeOption& option, const HedgePolicy& policy, const HedgeCosts& costs,
+                                 const HedgePaths& paths, int threads = 0);
+
+    // Reads one path per line as comma-separated spots ('#' comments allowed). Throws
+    // std::runtime_error on an unreadable file, a malformed value or unequal path lengths.
+    HedgePaths read_hedge_paths(const std::string& path);
+
+    // Moments and percentiles (linearly interpolated) of a sample.
+    HedgeDistribution hedge_distribution(std::vector<double> values);
+}
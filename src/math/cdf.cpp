@@ -1,8 +1,51 @@
 #include "math/cdf.h"
 #include <cmath>
+#include <limits>
 
 namespace GreeksCalculator {
     double normal_cdf(double x) {
-        return 0.5 * (1.0 + erf(x / sqrt(2.0)));
+        // erfc keeps full relative precision in the lower tail, where 1 + erf(x) cancels.
+        return 0.5 * erfc(-x / sqrt(2.0));
     }
-}
\ No newline at end of file
+
+    double inverse_normal_cdf(double p) {
+        if (!(p >= 0.0 && p <= 1.0)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        if (p == 0.0) {
+            return -std::numeric_limits<double>::infinity();
+        }
+        if (p == 1.0) {
+            return std::numeric_limits<double>::infinity();
+        }
+
+        // Acklam's rational approximation (relative error 1.15e-9), then one Halley step.
+        static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                                   1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+        static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                                   6.680131188771972e+01, -1.328068155288572e+01};
+        static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                                   -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+        static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                                   3.754408661907416e+00};
+        const double low = 0.02425;
+        double x;
+        if (p < low || p > 1.0 - low) {
+            double s = std::sqrt(-2.0 * std::log(p < low ? p : 1.0 - p));
+            x = (((((c[0] * s + c[1]) * s + c[2]) * s + c[3]) * s + c[4]) * s + c[5]) /
+                ((((d[0] * s + d[1]) * s + d[2]) * s + d[3]) * s + 1.0);
+            if (p > 1.0 - low) {
+                x = -x;
+            }
+        } else {
+            double s = p - 0.5, t = s * s;
+            x = (((((a[0] * t + a[1]) * t + a[2]) * t + a[3]) * t + a[4]) * t + a[5]) * s /
+                (((((b[0] * t + b[1]) * t + b[2]) * t + b[3]) * t + b[4]) * t + 1.0);
+        }
+
+        // N(x) - p, written through the lower tail so that it keeps its relative precision.
+        double e = x <= 0.0 ? normal_cdf(x) - p : (1.0 - p) - normal_cdf(-x);
+        double u = e * std::sqrt(2.0 * M_PI) * std::exp(0.5 * x * x);
+        return x - u / (1.0 + 0.5 * x * u);
+    }
+}
@@ -2,4 +2,7 @@
 
 namespace GreeksCalculator {
     double normal_cdf(double x);
+
+    // Inverse of normal_cdf on (0, 1); -inf/+inf at 0/1 and NaN outside [0, 1].
+    double inverse_normal_cdf(double p);
 }
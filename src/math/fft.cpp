@@ -0,0 +1,53 @@
+#include "math/fft.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace GreeksCalculator {
+    FftPlan::FftPlan(std::size_t n) : n_(n), twiddle_(n / 2) {
+        if (n == 0 || (n & (n - 1)) != 0) {
+            throw std::invalid_argument("FFT size must be a power of two.");
+        }
+        for (std::size_t k = 0; k < n / 2; ++k) {
+            twiddle_[k] = std::polar(1.0, -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(n));
+        }
+    }
+
+    void FftPlan::forward(std::complex<double>* data) const {
+        // Bit-reversal permutation, then butterflies of doubling length.
+        for (std::size_t i = 1, j = 0; i < n_; ++i) {
+            std::size_t bit = n_ >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j |= bit;
+            if (i < j) {
+                std::swap(data[i], data[j]);
+            }
+        }
+        // Butterflies on the interleaved (re, im) doubles that std::complex guarantees;
+        // complex operator* would add NaN/inf recovery we do not need.
+        double* x = reinterpret_cast<double*>(data);
+        const double* w = reinterpret_cast<const double*>(twiddle_.data());
+        for (std::size_t len = 2; len <= n_; len <<= 1) {
+            std::size_t half = len / 2, step = n_ / len;
+            for (std::size_t start = 0; start < n_; start += len) {
+                double* lo = x + 2 * start;
+                double* hi = lo + 2 * half;
+                for (std::size_t k = 0; k < half; ++k) {
+                    const double wr = w[2 * k * step], wi = w[2 * k * step + 1];
+                    const double br = hi[2 * k], bi = hi[2 * k + 1];
+                    const double tr = wr * br - wi * bi, ti = wr * bi + wi * br;
+                    hi[2 * k] = lo[2 * k] - tr;
+                    hi[2 * k + 1] = lo[2 * k + 1] - ti;
+                    lo[2 * k] += tr;
+                    lo[2 * k + 1] += ti;
+                }
+            }
+        }
+    }
+
+    void fft(std::vector<std::complex<double>>& data) {
+        FftPlan(data.size()).forward(data.data());
+    }
+}
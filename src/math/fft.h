@@ -0,0 +1,24 @@
+#pragma once
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+namespace GreeksCalculator {
+    // In-place forward discrete Fourier transform, X[k] = sum_j x[j] exp(-2 pi i j k / N),
+    // by iterative radix-2 Cooley-Tukey. N must be a power of two (std::invalid_argument
+    // otherwise).
+    void fft(std::vector<std::complex<double>>& data);
+
+    // The same transform with a precomputed twiddle table, for repeated transforms of one size.
+    class FftPlan {
+    public:
+        explicit FftPlan(std::size_t n);
+
+        std::size_t size() const { return n_; }
+        void forward(std::complex<double>* data) const;
+
+    private:
+        std::size_t n_;
+        std::vector<std::complex<double>> twiddle_;     // exp(-2 pi i k / N), k < N/2
+    };
+}
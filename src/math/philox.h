@@ -0,0 +1,60 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace GreeksCalculator {
+    // Philox4x32-10 counter-based generator (Salmon et al., SC'11). The output is a
+    // pure function of (key, counter), so any sample can be regenerated from its
+    // index alone, independent of how work is split across threads.
+    struct Philox4x32 {
+        using Counter = std::array<std::uint32_t, 4>;
+        using Key = std::array<std::uint32_t, 2>;
+
+        static Counter generate(Counter ctr, Key key) {
+            for (int round = 0; round < 10; ++round) {
+                std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * ctr[0];
+                std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * ctr[2];
+                ctr = {static_cast<std::uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+                       static_cast<std::uint32_t>(p1),
+                       static_cast<std::uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+                       static_cast<std::uint32_t>(p0)};
+                key[0] += 0x9E3779B9u;
+                key[1] += 0xBB67AE85u;
+            }
+            return ctr;
+        }
+
+        static Key make_key(std::uint64_t seed) {
+            return {static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32)};
+        }
+    };
+
+    // Maps a 32-bit draw to (0, 1), never returning exactly 0 or 1.
+    inline double uniform_open(std::uint32_t x) {
+        return (static_cast<double>(x) + 0.5) * (1.0 / 4294967296.0);
+    }
+
+    // Fills out[0, n) with standard normals for indices [first, first + n) of the
+    // stream identified by (key, stream). Four normals come from each Philox block
+    // via Box-Muller, so index i always maps to the same value.
+    inline void philox_normals(Philox4x32::Key key, std::uint32_t stream, std::uint64_t first, double* out, std::size_t n) {
+        constexpr double two_pi = 6.283185307179586476925286766559;
+        std::uint64_t index = first;
+        std::size_t written = 0;
+        while (written < n) {
+            std::uint64_t block = index / 4;
+            Philox4x32::Counter bits = Philox4x32::generate(
+                {static_cast<std::uint32_t>(block), static_cast<std::uint32_t>(block >> 32), stream, 0u}, key);
+            double r0 = std::sqrt(-2.0 * std::log(uniform_open(bits[0])));
+            double r1 = std::sqrt(-2.0 * std::log(uniform_open(bits[2])));
+            double a0 = two_pi * uniform_open(bits[1]);
+            double a1 = two_pi * uniform_open(bits[3]);
+            double z[4] = {r0 * std::cos(a0), r0 * std::sin(a0), r1 * std::cos(a1), r1 * std::sin(a1)};
+            for (std::size_t lane = index % 4; lane < 4 && written < n; ++lane, ++index, ++written) {
+                out[written] = z[lane];
+            }
+        }
+    }
+}
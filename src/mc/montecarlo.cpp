@@ -0,0 +1,180 @@
+#include "mc/montecarlo.h"
+#include "bsm/validation.h"
+#include "math/common.h"
+#include "math/maths.h"
+#include "math/philox.h"
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace GreeksCalculator {
+    namespace {
+        // Fixed block size keeps the reduction order, and therefore the result,
+        // identical for any thread count.
+        constexpr std::size_t kBlockSamples = 4096;
+
+        enum Estimator {
+            kPrice, kDeltaPW, kDeltaLR, kGammaPW, kGammaLR, kVegaPW, kVegaLR, kVannaPW, kVannaLR, kEstimatorCount
+        };
+
+        struct BlockSums {
+            double sum[kEstimatorCount] = {};
+            double sum_sq[kEstimatorCount] = {};
+            double control = 0.0;
+            double control_sq = 0.0;
+            double control_cross = 0.0;
+        };
+
+        struct PathModel {
+            double S, K, T, sigma, phi;
+            double drift, vol, sqrtT, discount;
+        };
+
+        void evaluate(const PathModel& m, double z, double ST, double* out) {
+            double payoff = std::max(m.phi * (ST - m.K), 0.0);
+            double slope = payoff > 0.0 ? m.phi : 0.0;
+            double sigma_score = (z * z - 1.0) / m.sigma - z * m.sqrtT;
+            double dp = m.discount * payoff;
+            double ds = m.discount * slope * ST;
+
+            out[kPrice] = dp;
+            out[kDeltaPW] = ds / m.S;
+            out[kDeltaLR] = dp * z / (m.S * m.vol);
+            out[kGammaPW] = ds / (m.S * m.S) * (z / m.vol - 1.0);
+            out[kGammaLR] = dp * ((z * z - 1.0) / (m.vol * m.vol) - z / m.vol) / (m.S * m.S);
+            out[kVegaPW] = ds * (z * m.sqrtT - m.sigma * m.T);
+            out[kVegaLR] = dp * sigma_score;
+            out[kVannaPW] = ds / m.S * sigma_score;
+            out[kVannaLR] = dp * ((1.0 - z * z) / m.sigma + (z * z * z - 3.0 * z) / (m.sigma * m.vol)) / m.S;
+        }
+
+        void simulate_block(const PathModel& m, Philox4x32::Key key, bool antithetic, std::size_t first, std::size_t count, BlockSums& sums) {
+            double z[kBlockSamples];
+            double ST[kBlockSamples];
+            double ST_anti[kBlockSamples];
+
+            // Draw the whole block first so the exp() loops run over contiguous arrays.
+            philox_normals(key, 0u, first, z, count);
+            for (std::size_t i = 0; i < count; ++i) {
+                ST[i] = m.S * std::exp(m.drift + m.vol * z[i]);
+            }
+            if (antithetic) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    ST_anti[i] = m.S * std::exp(m.drift - m.vol * z[i]);
+                }
+            }
+
+            double est[kEstimatorCount];
+            double est_anti[kEstimatorCount];
+            for (std::size_t i = 0; i < count; ++i) {
+                evaluate(m, z[i], ST[i], est);
+                double y = m.discount * ST[i];
+                if (antithetic) {
+                    evaluate(m, -z[i], ST_anti[i], est_anti);
+                    for (int e = 0; e < kEstimatorCount; ++e) {
+                        est[e] = 0.5 * (est[e] + est_anti[e]);
+                    }
+                    y = 0.5 * (y + m.discount * ST_anti[i]);
+                }
+                for (int e = 0; e < kEstimatorCount; ++e) {
+                    sums.sum[e] += est[e];
+                    sums.sum_sq[e] += est[e] * est[e];
+                }
+                sums.control += y;
+                sums.control_sq += y * y;
+                sums.control_cross += y * est[kPrice];
+            }
+        }
+
+        MonteCarloEstimate summarize(double sum, double sum_sq, double n) {
+            MonteCarloEstimate e;
+            e.value = sum / n;
+            double var = std::max((sum_sq - n * e.value * e.value) / (n - 1.0), 0.0);
+            e.std_error = std::sqrt(var / n);
+            return e;
+        }
+
+        MonteCarloEstimate scaled(MonteCarloEstimate e, double factor) {
+            e.value *= factor;
+            e.std_error *= factor;
+            return e;
+        }
+    }
+
+    MonteCarloGreeks monte_carlo_greeks(bool call, double S, double K, double T, double r, double sigma, double q,
+                                        const MonteCarloParams& params, const ScalingParams& scaling) {
+        validate_inputs(S, K, T, r, sigma, q);
+        if (params.paths < 2) {
+            throw std::invalid_argument("Monte Carlo requires at least two paths.");
+        }
+
+        PathModel m;
+        m.S = S;
+        m.K = K;
+        m.T = T;
+        m.sigma = sigma;
+        m.phi = call ? 1.0 : -1.0;
+        m.drift = (r - q - 0.5 * sigma * sigma) * T;
+        m.vol = sigma_sqrt_time(sigma, T);
+        m.sqrtT = sqrt_time(T);
+        m.discount = safe_exp(-r * T);
+
+        // With antithetics each sample is the average of a (z, -z) pair.
+        std::size_t samples = params.antithetic ? (params.paths + 1) / 2 : params.paths;
+        samples = std::max<std::size_t>(samples, 2);
+        std::size_t blocks = (samples + kBlockSamples - 1) / kBlockSamples;
+        std::vector<BlockSums> partial(blocks);
+        Philox4x32::Key key = Philox4x32::make_key(params.seed);
+
+        parallel_for(blocks, params.threads, [&](std::size_t b) {
+            std::size_t first = b * kBlockSamples;
+            std::size_t count = std::min(kBlockSamples, samples - first);
+            simulate_block(m, key, params.antithetic, first, count, partial[b]);
+        });
+
+        BlockSums total;
+        for (const BlockSums& p : partial) {
+            for (int e = 0; e < kEstimatorCount; ++e) {
+                total.sum[e] += p.sum[e];
+                total.sum_sq[e] += p.sum_sq[e];
+            }
+            total.control += p.control;
+            total.control_sq += p.control_sq;
+            total.control_cross += p.control_cross;
+        }
+
+        double n = static_cast<double>(samples);
+        MonteCarloEstimate e[kEstimatorCount];
+        for (int k = 0; k < kEstimatorCount; ++k) {
+            e[k] = summarize(total.sum[k], total.sum_sq[k], n);
+        }
+
+        if (params.control_variate) {
+            double mean_y = total.control / n;
+            double var_y = (total.control_sq - n * mean_y * mean_y) / (n - 1.0);
+            double cov = (total.control_cross - n * mean_y * e[kPrice].value) / (n - 1.0);
+            if (var_y > 0.0) {
+                double beta = cov / var_y;
+                double var_x = e[kPrice].std_error * e[kPrice].std_error * n;
+                e[kPrice].value -= beta * (mean_y - S * exp_dividend(q, T));
+                e[kPrice].std_error = std::sqrt(std::max(var_x - beta * cov, 0.0) / n);
+            }
+        }
+
+        double vega_factor = scale_vega(1.0, scaling);
+        MonteCarloGreeks g;
+        g.price = e[kPrice];
+        g.delta_pathwise = e[kDeltaPW];
+        g.delta_lr = e[kDeltaLR];
+        g.gamma_pathwise = e[kGammaPW];
+        g.gamma_lr = e[kGammaLR];
+        g.vega_pathwise = scaled(e[kVegaPW], vega_factor);
+        g.vega_lr = scaled(e[kVegaLR], vega_factor);
+        g.vanna_pathwise = scaled(e[kVannaPW], vega_factor);
+        g.vanna_lr = scaled(e[kVannaLR], vega_factor);
+        g.paths = params.antithetic ? 2 * samples : samples;
+        return g;
+    }
+}
@@ -0,0 +1,84 @@
+#include "models/models.h"
+#include "models/implied.h"
+#include "math/cdf.h"
+#include "math/common.h"
+#include "math/maths.h"
+#include "math/pdf.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GreeksCalculator {
+    bool BachelierModel::valid(double F, double K, double T, double r, double sigma) {
+        return T > 0.0 && sigma > 0.0 && std::isfinite(F) && std::isfinite(K) && std::isfinite(T) && std::isfinite(r) &&
+               std::isfinite(sigma);
+    }
+
+    double BachelierModel::price(bool call, double F, double K, double T, double r, double sigma) {
+        double v = sigma * std::sqrt(T);
+        double d = (F - K) / v;
+        double w = call ? 1.0 : -1.0;
+        return std::exp(-r * T) * (w * (F - K) * normal_cdf(w * d) + v * normal_pdf(d));
+    }
+
+    void BachelierModel::evaluate(GreekMask columns, bool call, double F, double K, double T, double r, double sigma,
+                                  const ScalingParams& scaling, Greeks& g) {
+        double sqT = std::sqrt(T), v = sigma * sqT;
+        double d = (F - K) / v, d2 = d * d;
+        double w = call ? 1.0 : -1.0;
+        double D = std::exp(-r * T);
+        double n = normal_pdf(d);
+        double N = normal_cdf(w * d);
+
+        double price = D * (w * (F - K) * N + v * n);
+        double delta = D * w * N;
+        double gamma = D * n / v;
+        double vega = D * n * sqT;
+        auto want = [columns](GreekColumn c) { return (columns & greek_bit(c)) != 0; };
+
+        g.price = price;
+        if (want(GreekColumn::Delta)) g.delta = delta;
+        if (want(GreekColumn::Vega)) g.vega = scale_vega(vega, scaling);
+        if (want(GreekColumn::Theta)) g.theta = scale_theta(r * price - D * n * sigma / (2.0 * sqT), scaling);
+        if (want(GreekColumn::Rho)) g.rho = scale_rho(-T * price, scaling);
+        if (want(GreekColumn::Lambda)) g.lambda = safe_divide(delta * F, price);
+
+        if (want(GreekColumn::Gamma)) g.gamma = gamma;
+        if (want(GreekColumn::Vanna)) g.vanna = scale_vega(-D * n * d / sigma, scaling);
+        if (want(GreekColumn::Charm)) g.charm = scale_charm(r * delta + D * n * d / (2.0 * T), scaling);
+        if (want(GreekColumn::Volga)) g.volga = scale_vega(vega * d2 / sigma, scaling);
+        if (want(GreekColumn::Veta)) g.veta = scale_vega(scale_charm(vega * (r - (1.0 + d2) / (2.0 * T)), scaling), scaling);
+        if (want(GreekColumn::Vera)) g.vera = scale_rho(-T * vega, scaling);
+
+        // d^n V / dF^n = D phi^(n-2)(d) / v^(n-1) = D (-1)^n He_(n-2)(d) phi(d) / v^(n-1).
+        if (want(GreekColumn::Speed)) g.speed = -gamma * d / v;
+        if (want(GreekColumn::Zomma)) g.zomma = scale_vega(gamma * (d2 - 1.0) / sigma, scaling);
+        if (want(GreekColumn::Color)) g.color = scale_color(gamma * (r + (1.0 - d2) / (2.0 * T)), scaling);
+        if (want(GreekColumn::Ultima)) g.ultima = scale_vega(vega * d2 * (d2 - 3.0) / (sigma * sigma), scaling);
+        if (want(GreekColumn::DvannaDvol)) g.dvanna_dvol = scale_vega(-D * n * d * (d2 - 2.0) / (sigma * sigma), scaling);
+
+        if (want(GreekColumn::Snap)) g.snap = gamma * (d2 - 1.0) / (v * v);
+        if (want(GreekColumn::Jounce)) g.jounce = -gamma * d * (d2 - 3.0) / (v * v * v);
+        if (want(GreekColumn::Pounce)) g.pounce = gamma * (d2 * d2 - 6.0 * d2 + 3.0) / (v * v * v * v);
+    }
+
+    double BachelierModel::implied_volatility(bool call, double F, double K, double T, double r, double price) {
+        double D = std::exp(-r * T);
+        double lower = D * std::max(call ? F - K : K - F, 0.0);
+        if (!valid(F, K, T, r, 1.0) || !(price > lower) || !std::isfinite(price)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        // Solve on the out-of-the-money side, whose price is all time value (put-call parity).
+        if (lower > 0.0) {
+            price -= lower;
+            lower = 0.0;
+            call = !call;
+        }
+        // At the money the normal price is D sigma sqrt(T / 2 pi).
+        double sqT = std::sqrt(T);
+        double guess = std::sqrt(2.0 * M_PI) * price / (D * sqT);
+        return detail::solve_implied_volatility(price, guess, [&](double sigma, double& vega) {
+            vega = D * normal_pdf((F - K) / (sigma * sqT)) * sqT;
+            return BachelierModel::price(call, F, K, T, r, sigma);
+        });
+    }
+}
@@ -0,0 +1,102 @@
+#include "models/models.h"
+#include "models/implied.h"
+#include "bsm/spot_derivatives.h"
+#include "math/cdf.h"
+#include "math/common.h"
+#include "math/maths.h"
+#include "math/pdf.h"
+#include <algorithm>
+#include <cmath>
+
+namespace GreeksCalculator {
+    bool Black76Model::valid(double F, double K, double T, double r, double sigma) {
+        return F > 0.0 && K > 0.0 && T > 0.0 && sigma > 0.0 && std::isfinite(F) && std::isfinite(K) && std::isfinite(T) &&
+               std::isfinite(r) && std::isfinite(sigma);
+    }
+
+    double Black76Model::price(bool call, double F, double K, double T, double r, double sigma) {
+        double v = sigma * std::sqrt(T);
+        double d1 = std::log(F / K) / v + 0.5 * v, d2 = d1 - v;
+        double w = call ? 1.0 : -1.0;
+        return std::exp(-r * T) * w * (F * normal_cdf(w * d1) - K * normal_cdf(w * d2));
+    }
+
+    void Black76Model::evaluate(GreekMask columns, bool call, double F, double K, double T, double r, double sigma,
+                                const ScalingParams& scaling, Greeks& g) {
+        double sqT = std::sqrt(T), v = sigma * sqT;
+        double d1 = std::log(F / K) / v + 0.5 * v, d2 = d1 - v;
+        double w = call ? 1.0 : -1.0;
+        double D = std::exp(-r * T);
+        double n1 = normal_pdf(d1);
+        double N1 = normal_cdf(w * d1), N2 = normal_cdf(w * d2);
+
+        double price = D * w * (F * N1 - K * N2);
+        double delta = D * w * N1;
+        double gamma = D * n1 / (F * v);
+        double vega = D * F * n1 * sqT;
+        auto want = [columns](GreekColumn c) { return (columns & greek_bit(c)) != 0; };
+
+        g.price = price;
+        if (want(GreekColumn::Delta)) g.delta = delta;
+        if (want(GreekColumn::Vega)) g.vega = scale_vega(vega, scaling);
+        if (want(GreekColumn::Theta)) g.theta = scale_theta(r * price - D * F * n1 * sigma / (2.0 * sqT), scaling);
+        if (want(GreekColumn::Rho)) g.rho = scale_rho(-T * price, scaling);
+        if (want(GreekColumn::Lambda)) g.lambda = safe_divide(delta * F, price);
+
+        if (want(GreekColumn::Gamma)) g.gamma = gamma;
+        if (want(GreekColumn::Vanna)) g.vanna = scale_vega(-D * n1 * d2 / sigma, scaling);
+        if (want(GreekColumn::Charm)) g.charm = scale_charm(r * delta + D * n1 * d2 / (2.0 * T), scaling);
+        if (want(GreekColumn::Volga)) g.volga = scale_vega(vega * d1 * d2 / sigma, scaling);
+        if (want(GreekColumn::Veta)) g.veta = scale_vega(scale_charm(vega * (r - (1.0 + d1 * d2) / (2.0 * T)), scaling), scaling);
+        if (want(GreekColumn::Vera)) g.vera = scale_rho(-T * vega, scaling);
+
+        if (want(GreekColumn::Speed)) g.speed = -gamma * (d1 / v + 1.0) / F;
+        if (want(GreekColumn::Zomma)) g.zomma = scale_vega(gamma * (d1 * d2 - 1.0) / sigma, scaling);
+        if (want(GreekColumn::Color)) g.color = scale_color(gamma * (r + (1.0 - d1 * d2) / (2.0 * T)), scaling);
+        if (want(GreekColumn::Ultima)) {
+            g.ultima = scale_vega(-vega * (d1 * d2 * (1.0 - d1 * d2) + d1 * d1 + d2 * d2) / (sigma * sigma), scaling);
+        }
+        if (want(GreekColumn::DvannaDvol)) {
+            g.dvanna_dvol = scale_vega(-D * n1 * (d1 * d2 * d2 - d1 - d2) / (sigma * sigma), scaling);
+        }
+
+        // Black-76 is BSM on the forward with q = r, so the spot recurrence gives the F derivatives.
+        int order = 0;
+        for (GreekColumn c : {GreekColumn::Snap, GreekColumn::Jounce, GreekColumn::Pounce}) {
+            int n = c == GreekColumn::Snap ? 4 : c == GreekColumn::Jounce ? 5 : 6;
+            if (want(c) && higher_order_enabled(n, T, sigma)) {
+                order = n;
+            }
+        }
+        if (order > 0) {
+            double spot[7];
+            spot_derivatives(call, F, K, T, r, sigma, r, order, spot);
+            if (want(GreekColumn::Snap) && higher_order_enabled(4, T, sigma)) g.snap = spot[4];
+            if (want(GreekColumn::Jounce) && higher_order_enabled(5, T, sigma)) g.jounce = spot[5];
+            if (want(GreekColumn::Pounce) && higher_order_enabled(6, T, sigma)) g.pounce = spot[6];
+        }
+    }
+
+    double Black76Model::implied_volatility(bool call, double F, double K, double T, double r, double price) {
+        double D = std::exp(-r * T);
+        double lower = D * std::max(call ? F - K : K - F, 0.0);
+        double upper = D * (call ? F : K);
+        if (!valid(F, K, T, r, 0.1) || !(price > lower && price < upper)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        // Solve on the out-of-the-money side, whose price is all time value (put-call parity).
+        if (lower > 0.0) {
+            price -= lower;
+            lower = 0.0;
+            call = !call;
+        }
+        // Brenner-Subrahmanyam's at-the-money estimate on the time value.
+        double guess = std::sqrt(2.0 * M_PI / T) * price / (D * F);
+        double sqT = std::sqrt(T);
+        return detail::solve_implied_volatility(price, std::min(std::max(guess, 1e-3), 5.0), [&](double sigma, double& vega) {
+            double v = sigma * sqT;
+            vega = D * F * normal_pdf(std::log(F / K) / v + 0.5 * v) * sqT;
+            return Black76Model::price(call, F, K, T, r, sigma);
+        });
+    }
+}
@@ -0,0 +1,312 @@
+#include "models/heston.h"
+#include "math/common.h"
+#include "math/maths.h"
+#include "parallel/parallel.h"
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    namespace {
+        using cd = std::complex<double>;
+
+        // Terms whose transforms make up the Greeks, as multipliers of the integrand psi(u):
+        // a = iu is d/dx (x = log S), D = d/dv0 and L = d/dT of log psi.
+        enum Term : int {
+            One, A, A2, A3, A4,         // Spot derivatives
+            D1, D2, D3,                 // v0 derivatives
+            AD, A2D, AD2,               // Mixed spot/v0
+            L1, AL, A2L,                // Time, with spot
+            DTerm,                      // d(D psi)/dT / psi = D_T + D L
+            TermCount
+        };
+
+        // std::complex's operator* adds NaN/inf recovery that dominates these loops.
+        inline cd mul(cd x, cd y) {
+            return {x.real() * y.real() - x.imag() * y.imag(), x.real() * y.imag() + x.imag() * y.real()};
+        }
+
+        constexpr std::uint32_t term(Term t) {
+            return 1u << t;
+        }
+
+        std::uint32_t terms_for(GreekMask columns) {
+            auto want = [columns](GreekColumn c) { return (columns & greek_bit(c)) != 0; };
+            std::uint32_t t = term(One);
+            if (want(GreekColumn::Delta) || want(GreekColumn::Lambda) || want(GreekColumn::Rho) ||
+                want(GreekColumn::Epsilon) || want(GreekColumn::Gamma) || want(GreekColumn::Speed) ||
+                want(GreekColumn::Snap)) t |= term(A);
+            if (want(GreekColumn::Gamma) || want(GreekColumn::Speed) || want(GreekColumn::Snap)) t |= term(A2);
+            if (want(GreekColumn::Speed) || want(GreekColumn::Snap)) t |= term(A3);
+            if (want(GreekColumn::Snap)) t |= term(A4);
+            if (want(GreekColumn::Vega) || want(GreekColumn::Volga) || want(GreekColumn::Vera)) t |= term(D1);
+            if (want(GreekColumn::Volga) || want(GreekColumn::Ultima)) t |= term(D2);
+            if (want(GreekColumn::Ultima)) t |= term(D3);
+            if (want(GreekColumn::Vanna) || want(GreekColumn::Vera) || want(GreekColumn::Zomma) ||
+                want(GreekColumn::DvannaDvol)) t |= term(AD);
+            if (want(GreekColumn::Zomma)) t |= term(A2D);
+            if (want(GreekColumn::DvannaDvol)) t |= term(AD2);
+            if (want(GreekColumn::Theta)) t |= term(L1);
+            if (want(GreekColumn::Charm) || want(GreekColumn::Color)) t |= term(AL);
+            if (want(GreekColumn::Color)) t |= term(A2L);
+            if (want(GreekColumn::Veta)) t |= term(DTerm);
+            return t;
+        }
+    }
+
+    // Characteristic-function values at the FFT nodes for one expiry, and the transforms
+    // computed from them so far. Immutable once published to the cache.
+    struct HestonEngine::Slice {
+        double T = 0.0;
+        std::vector<cd> psi;        // Integrand with Simpson weight and grid phase folded in
+        std::vector<cd> a, D, DT, L;
+        std::uint32_t terms = 0;
+        std::vector<double> transform[TermCount];
+    };
+
+    bool heston_params_valid(const HestonParams& p) {
+        return p.v0 > 0.0 && p.kappa > 0.0 && p.theta > 0.0 && p.xi > 0.0 && std::isfinite(p.v0) &&
+               std::isfinite(p.kappa) && std::isfinite(p.theta) && std::isfinite(p.xi) && p.rho > -1.0 && p.rho < 1.0;
+    }
+
+    HestonEngine::HestonEngine(const HestonParams& params, double r, double q, const HestonFftOptions& options)
+        : params_(params), r_(r), q_(q), options_(options), plan_(options.points) {
+        if (!heston_params_valid(params) || !std::isfinite(r) || !std::isfinite(q) || !(options.eta > 0.0) ||
+            !(options.alpha > 0.0) || options.points < 16 || options.cached_expiries == 0) {
+            throw std::invalid_argument("Invalid Heston parameters or FFT options.");
+        }
+        // exp(-alpha m) / pi at each log-moneyness node m.
+        const double lambda = 2.0 * M_PI / (static_cast<double>(options.points) * options.eta);
+        damping_.resize(options.points);
+        for (std::size_t k = 0; k < options.points; ++k) {
+            const double m = lambda * (static_cast<double>(k) - 0.5 * static_cast<double>(options.points));
+            damping_[k] = std::exp(-options.alpha * m) / M_PI;
+        }
+    }
+
+    HestonEngine::~HestonEngine() = default;
+
+    void HestonEngine::build(Slice& s, std::uint32_t terms) const {
+        const std::size_t N = options_.points;
+        const double eta = options_.eta, alpha = options_.alpha;
+        const double lambda = 2.0 * M_PI / (static_cast<double>(N) * eta);
+        const double b = 0.5 * static_cast<double>(N) * lambda;
+
+        if (s.psi.empty()) {
+            const HestonParams& p = params_;
+            const double T = s.T, xi2 = p.xi * p.xi, discount = std::exp(-r_ * T);
+            s.psi.resize(N);
+            s.a.resize(N);
+            s.D.resize(N);
+            s.DT.resize(N);
+            s.L.resize(N);
+            for (std::size_t j = 0; j < N; ++j) {
+                const double v = eta * static_cast<double>(j);
+                const cd u(v, -(alpha + 1.0));
+                const cd iu(alpha + 1.0, v);
+                // Albrecher et al.'s form, continuous in u without branch tracking.
+                const cd beta = p.kappa - p.rho * p.xi * iu;
+                const cd d = std::sqrt(beta * beta + xi2 * (iu + u * u));
+                const cd g = (beta - d) / (beta + d);
+                const cd e = std::exp(-d * T);
+                const cd D = (beta - d) / xi2 * (1.0 - e) / (1.0 - g * e);
+                const cd C = iu * (r_ - q_) * T + p.kappa * p.theta / xi2 * ((beta - d) * T - 2.0 * std::log((1.0 - g * e) / (1.0 - g)));
+                const cd DT = 0.5 * xi2 * D * D - beta * D - 0.5 * (u * u + iu);
+                const cd denominator(alpha * alpha + alpha - v * v, (2.0 * alpha + 1.0) * v);
+                const double weight = eta / 3.0 * (j == 0 ? 1.0 : (j % 2 ? 4.0 : 2.0));
+
+                s.a[j] = iu;
+                s.D[j] = D;
+                s.DT[j] = DT;
+                s.L[j] = -r_ + iu * (r_ - q_) + p.kappa * p.theta * D + p.v0 * DT;
+                s.psi[j] = discount * std::exp(C + D * p.v0) / denominator * weight * std::polar(1.0, b * v);
+            }
+        }
+
+        std::vector<cd> work(N);
+        for (int t = 0; t < TermCount; ++t) {
+            if (!(terms & term(static_cast<Term>(t))) || (s.terms & term(static_cast<Term>(t)))) {
+                continue;
+            }
+            for (std::size_t j = 0; j < N; ++j) {
+                const cd a = s.a[j], D = s.D[j];
+                const cd L = s.L[j];
+                cd m = 1.0;
+                switch (t) {
+                    case One: break;
+                    case A: m = a; break;
+                    case A2: m = mul(a, a); break;
+                    case A3: m = mul(mul(a, a), a); break;
+                    case A4: m = mul(mul(a, a), mul(a, a)); break;
+                    case D1: m = D; break;
+                    case D2: m = mul(D, D); break;
+                    case D3: m = mul(mul(D, D), D); break;
+                    case AD: m = mul(a, D); break;
+                    case A2D: m = mul(mul(a, a), D); break;
+                    case AD2: m = mul(a, mul(D, D)); break;
+                    case L1: m = L; break;
+                    case AL: m = mul(a, L); break;
+                    case A2L: m = mul(mul(a, a), L); break;
+                    case DTerm: m = s.DT[j] + mul(D, L); break;
+                }
+                work[j] = mul(s.psi[j], m);
+            }
+            plan_.forward(work.data());
+            std::vector<double>& out = s.transform[t];
+            out.resize(N);
+            for (std::size_t k = 0; k < N; ++k) {
+                out[k] = damping_[k] * work[k].real();
+            }
+            s.terms |= term(static_cast<Term>(t));
+        }
+    }
+
+    std::shared_ptr<const HestonEngine::Slice> HestonEngine::slice(double T, std::uint32_t terms) {
+        std::shared_ptr<const Slice> cached;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = cache_.find(T);
+            if (it != cache_.end()) {
+                cached = it->second.slice;
+                it->second.last_used = ++cache_clock_;
+            }
+        }
+        if (cached && (cached->terms & terms) == terms) {
+            return cached;
+        }
+
+        // Extend a copy so readers of the cached slice are never disturbed; the
+        // characteristic function is evaluated only the first time.
+        auto fresh = cached ? std::make_shared<Slice>(*cached) : std::make_shared<Slice>();
+        fresh->T = T;
+        build(*fresh, terms | (cached ? cached->terms : 0));
+        std::lock_guard<std::mutex> lock(mutex_);
+        CacheEntry& entry = cache_[T];
+        if (!entry.slice || (entry.slice->terms & fresh->terms) != fresh->terms) {
+            entry.slice = fresh;
+        }
+        entry.last_used = ++cache_clock_;
+        if (cache_.size() > options_.cached_expiries) {
+            auto oldest = cache_.begin();
+            for (auto it = cache_.begin(); it != cache_.end(); ++it) {
+                if (it->second.last_used < oldest->second.last_used) {
+                    oldest = it;
+                }
+            }
+            cache_.erase(oldest);
+        }
+        return fresh;
+    }
+
+    std::size_t HestonEngine::price_chain(double S, double T, const double* strikes, const std::uint8_t* call,
+                                          std::size_t n, Greeks* out, GreekMask columns, const ScalingParams& scaling) {
+        columns &= kHestonColumns;
+        if (!(S > 0.0) || !(T > 0.0) || !std::isfinite(S) || !std::isfinite(T)) {
+            return n;
+        }
+        auto want = [columns](GreekColumn c) { return (columns & greek_bit(c)) != 0; };
+        std::shared_ptr<const Slice> s = slice(T, terms_for(columns));
+
+        const std::size_t N = options_.points;
+        const double lambda = 2.0 * M_PI / (static_cast<double>(N) * options_.eta);
+        const double b = 0.5 * static_cast<double>(N) * lambda;
+        const double sigma0 = std::sqrt(params_.v0), v0 = params_.v0;
+        const double dq = std::exp(-q_ * T), dr = std::exp(-r_ * T);
+
+        std::size_t failures = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double K = strikes[i];
+            const double pos = (std::log(K / S) + b) / lambda;
+            if (!(K > 0.0) || !std::isfinite(K) || !(pos >= 1.0) || !(pos < static_cast<double>(N) - 2.0)) {
+                ++failures;
+                continue;
+            }
+            // Four-point Lagrange interpolation in log-moneyness.
+            const std::size_t j = static_cast<std::size_t>(pos);
+            const double x = pos - static_cast<double>(j);
+            const double w[4] = {-x * (x - 1.0) * (x - 2.0) / 6.0, (x + 1.0) * (x - 1.0) * (x - 2.0) / 2.0,
+                                 -(x + 1.0) * x * (x - 2.0) / 2.0, (x + 1.0) * x * (x - 1.0) / 6.0};
+            double c[TermCount];
+            for (int t = 0; t < TermCount; ++t) {
+                if (s->terms & term(static_cast<Term>(t))) {
+                    const double* f = s->transform[t].data() + j - 1;
+                    c[t] = S * (w[0] * f[0] + w[1] * f[1] + w[2] * f[2] + w[3] * f[3]);
+                } else {
+                    c[t] = std::numeric_limits<double>::quiet_NaN();
+                }
+            }
+
+            // Call values, then put-call parity: P = C + K e^{-rT} - S e^{-qT}.
+            const bool put = call && call[i] == 0;
+            const double S2 = S * S, S3 = S2 * S;
+            double price = c[One];
+            double delta = c[A] / S;
+            double theta = -c[L1];
+            double rho = T * (c[A] - c[One]);
+            double epsilon = -T * c[A];
+            double charm = -c[AL] / S;
+            if (put) {
+                price += K * dr - S * dq;
+                delta -= dq;
+                theta += r_ * K * dr - q_ * S * dq;
+                rho -= T * K * dr;
+                epsilon += T * S * dq;
+                charm -= q_ * dq;
+            }
+
+            Greeks& g = out[i];
+            g.price = price;
+            if (want(GreekColumn::Delta)) g.delta = delta;
+            if (want(GreekColumn::Vega)) g.vega = scale_vega(2.0 * sigma0 * c[D1], scaling);
+            if (want(GreekColumn::Theta)) g.theta = scale_theta(theta, scaling);
+            if (want(GreekColumn::Rho)) g.rho = scale_rho(rho, scaling);
+            if (want(GreekColumn::Lambda)) g.lambda = safe_divide(delta * S, price);
+            if (want(GreekColumn::Epsilon)) g.epsilon = scale_epsilon(epsilon, scaling);
+
+            if (want(GreekColumn::Gamma)) g.gamma = (c[A2] - c[A]) / S2;
+            if (want(GreekColumn::Vanna)) g.vanna = scale_vega(2.0 * sigma0 * c[AD] / S, scaling);
+            if (want(GreekColumn::Charm)) g.charm = scale_charm(charm, scaling);
+            if (want(GreekColumn::Volga)) g.volga = scale_vega(2.0 * c[D1] + 4.0 * v0 * c[D2], scaling);
+            if (want(GreekColumn::Veta)) g.veta = scale_vega(scale_charm(-2.0 * sigma0 * c[DTerm], scaling), scaling);
+            if (want(GreekColumn::Vera)) g.vera = scale_rho(2.0 * sigma0 * T * (c[AD] - c[D1]), scaling);
+
+            if (want(GreekColumn::Speed)) g.speed = (c[A3] - 3.0 * c[A2] + 2.0 * c[A]) / S3;
+            if (want(GreekColumn::Zomma)) g.zomma = scale_vega(2.0 * sigma0 * (c[A2D] - c[AD]) / S2, scaling);
+            if (want(GreekColumn::Color)) g.color = scale_color(-(c[A2L] - c[AL]) / S2, scaling);
+            if (want(GreekColumn::Ultima)) g.ultima = scale_vega(12.0 * sigma0 * c[D2] + 8.0 * sigma0 * v0 * c[D3], scaling);
+            if (want(GreekColumn::DvannaDvol)) g.dvanna_dvol = scale_vega((2.0 * c[AD] + 4.0 * v0 * c[AD2]) / S, scaling);
+            if (want(GreekColumn::Snap)) g.snap = (c[A4] - 6.0 * c[A3] + 11.0 * c[A2] - 6.0 * c[A]) / (S2 * S2);
+        }
+        return failures;
+    }
+
+    std::size_t HestonEngine::price_chains(double S, std::vector<HestonChain>& chains, GreekMask columns,
+                                           const ScalingParams& scaling, int threads) {
+        std::vector<std::size_t> failures(chains.size(), 0);
+        parallel_for(chains.size(), threads, [&](std::size_t e) {
+            HestonChain& chain = chains[e];
+            if (!chain.call.empty() && chain.call.size() != chain.strikes.size()) {
+                throw std::invalid_argument("HestonChain call flags must match its strikes.");
+            }
+            chain.greeks.assign(chain.strikes.size(), Greeks{});
+            failures[e] = price_chain(S, chain.T, chain.strikes.data(), chain.call.empty() ? nullptr : chain.call.data(),
+                                      chain.strikes.size(), chain.greeks.data(), columns, scaling);
+        });
+        std::size_t total = 0;
+        for (std::size_t f : failures) {
+            total += f;
+        }
+        return total;
+    }
+
+    std::size_t HestonEngine::cached_expiries() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return cache_.size();
+    }
+
+    void HestonEngine::clear_cache() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
+    }
+}
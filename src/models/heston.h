@@ -0,0 +1,107 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/columns.h"
+#include "math/fft.h"
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace GreeksCalculator {
+    // Heston stochastic volatility: dS = (r - q) S dt + sqrt(v) S dW1,
+    // dv = kappa (theta - v) dt + xi sqrt(v) dW2, d<W1, W2> = rho dt.
+    struct HestonParams {
+        double v0 = 0.04;       // Initial variance
+        double kappa = 1.5;     // Mean-reversion speed
+        double theta = 0.04;    // Long-run variance
+        double xi = 0.5;        // Volatility of variance
+        double rho = -0.7;      // Spot/variance correlation
+    };
+
+    // All parameters finite and positive, |rho| < 1.
+    bool heston_params_valid(const HestonParams& p);
+
+    // Carr-Madan grid: `points` frequencies spaced `eta` apart give log-moneyness nodes
+    // 2 pi / (points eta) apart, centred on the money.
+    struct HestonFftOptions {
+        std::size_t points = 4096;      // Power of two
+        double eta = 0.25;
+        double alpha = 1.5;             // Damping exponent of the call price in log-strike
+        std::size_t cached_expiries = 64;   // Least recently used expiries beyond this are evicted
+    };
+
+    // Columns the engine fills. The volatility Greeks (vega, vanna, volga, veta, vera,
+    // zomma, ultima, dvanna_dvol) are taken with respect to the instantaneous volatility
+    // sqrt(v0) with kappa, theta, xi and rho fixed; the rest keep their BSM meanings.
+    constexpr GreekMask kHestonColumns =
+        greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) | greek_bit(GreekColumn::Vega) |
+        greek_bit(GreekColumn::Theta) | greek_bit(GreekColumn::Rho) | greek_bit(GreekColumn::Lambda) |
+        greek_bit(GreekColumn::Epsilon) | greek_bit(GreekColumn::Gamma) | greek_bit(GreekColumn::Vanna) |
+        greek_bit(GreekColumn::Charm) | greek_bit(GreekColumn::Volga) | greek_bit(GreekColumn::Veta) |
+        greek_bit(GreekColumn::Vera) | greek_bit(GreekColumn::Speed) | greek_bit(GreekColumn::Zomma) |
+        greek_bit(GreekColumn::Color) | greek_bit(GreekColumn::Ultima) | greek_bit(GreekColumn::DvannaDvol) |
+        greek_bit(GreekColumn::Snap);
+
+    // One expiry's strikes for HestonEngine::price_chains.
+    struct HestonChain {
+        double T = 0.0;
+        std::vector<double> strikes;
+        std::vector<std::uint8_t> call;     // Non-zero for calls; empty means every strike is a call
+        std::vector<Greeks> greeks;         // Output, one per strike
+    };
+
+    // Prices whole strike chains by Carr-Madan FFT of the Heston characteristic function.
+    // Each Greek is the transform of the characteristic function times its analytic
+    // derivative (powers of iu for spot, the variance coefficient D(u, T) for v0, and the
+    // Riccati right-hand side for T), so one FFT per needed term prices every strike of an
+    // expiry at once, and puts follow by put-call parity.
+    //
+    // The transforms are computed in log-moneyness with S = 1 and cached per expiry, so
+    // later calls for the same expiry, at any spot and for any strikes, only interpolate.
+    // Entries are keyed on the exact T, so a caller that ages T between calls misses every
+    // time; the least recently used entries are evicted beyond options.cached_expiries.
+    // The cache assumes the engine's parameters, r and q; build a new engine when they
+    // change. All members are safe to call concurrently.
+    class HestonEngine {
+    public:
+        // Throws std::invalid_argument on invalid parameters, r, q or options.
+        HestonEngine(const HestonParams& params, double r, double q = 0.0, const HestonFftOptions& options = {});
+        ~HestonEngine();
+
+        // Fills the requested columns of out[i] for strikes[i] at spot S. Strikes that are
+        // not positive or fall outside the FFT grid (or every strike, if S or T is
+        // invalid) keep NaN. Returns the number of such strikes.
+        std::size_t price_chain(double S, double T, const double* strikes, const std::uint8_t* call, std::size_t n,
+                                Greeks* out, GreekMask columns = kHestonColumns,
+                                const ScalingParams& scaling = ScalingParams::standard());
+
+        // Prices every chain, expiries in parallel across `threads` workers (0 = all cores).
+        std::size_t price_chains(double S, std::vector<HestonChain>& chains, GreekMask columns = kHestonColumns,
+                                 const ScalingParams& scaling = ScalingParams::standard(), int threads = 0);
+
+        std::size_t cached_expiries() const;
+        void clear_cache();
+
+        const HestonParams& params() const { return params_; }
+
+    private:
+        struct Slice;
+        std::shared_ptr<const Slice> slice(double T, std::uint32_t terms);
+        void build(Slice& s, std::uint32_t terms) const;
+
+        HestonParams params_;
+        double r_, q_;
+        HestonFftOptions options_;
+        FftPlan plan_;
+        std::vector<double> damping_;
+        mutable std::mutex mutex_;
+        struct CacheEntry {
+            std::shared_ptr<const Slice> slice;
+            std::uint64_t last_used = 0;
+        };
+        std::map<double, CacheEntry> cache_;
+        std::uint64_t cache_clock_ = 0;
+    };
+}
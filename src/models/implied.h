@@ -0,0 +1,51 @@
+#pragma once
+#include <cmath>
+#include <limits>
+
+namespace GreeksCalculator {
+    namespace detail {
+        // Newton iteration on log(price) kept inside a bisection bracket, for positive prices
+        // that increase monotonically in sigma; the log keeps far out-of-the-money solves,
+        // whose price is exponentially small in sigma, close to linear. `price_vega(sigma, vega)`
+        // returns the price and sets the raw vega. `guess` is the first iterate; the bracket's
+        // upper end is found by stepping up tenfold from it. Callers pass out-of-the-money
+        // prices, since the time value of a deep in-the-money price is lost to cancellation.
+        template <typename PriceVega>
+        double solve_implied_volatility(double target, double guess, PriceVega price_vega) {
+            const double nan = std::numeric_limits<double>::quiet_NaN();
+            double lo = 0.0, hi = guess > 0.0 && std::isfinite(guess) ? guess : 1.0;
+            double vega = 0.0;
+            for (int i = 0; price_vega(hi, vega) < target; ++i) {
+                if (i == 400) {
+                    return nan;
+                }
+                lo = hi;
+                hi *= 10.0;
+            }
+
+            const double log_target = std::log(target);
+            double sigma = lo > 0.0 ? 0.5 * (lo + hi) : hi;
+            for (int i = 0; i < 100; ++i) {
+                double price = price_vega(sigma, vega);
+                double diff = std::log(price) - log_target;
+                if (std::abs(diff) <= 1e-14) {
+                    return sigma;
+                }
+                if (diff > 0.0) {
+                    hi = sigma;
+                } else {
+                    lo = sigma;
+                }
+                double next = vega > 0.0 ? sigma - diff * price / vega : nan;
+                if (!(next > lo && next < hi)) {
+                    next = 0.5 * (lo + hi);
+                }
+                if (std::abs(next - sigma) <= 4.0 * std::numeric_limits<double>::epsilon() * sigma) {
+                    return next;
+                }
+                sigma = next;
+            }
+            return nan;
+        }
+    }
+}
@@ -0,0 +1,124 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/batch.h"
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace GreeksCalculator {
+    // Pricing models for options on a forward F, discounted at r. A model is a type
+    // providing the static members below; every entry point takes it as a template
+    // parameter, so each model gets its own specialized row loop and there is no
+    // per-option dispatch.
+    //
+    // The Greeks use the BSM column meanings with F in place of S: delta, gamma, speed
+    // and the snap/jounce/pounce block are derivatives in F, theta, charm, veta and color
+    // are d/dt at fixed F, and rho is d/dr at fixed F (so rho = -T V). Columns follow
+    // `scaling` (vega_scale for every volatility derivative, rho_scale for rho and vera,
+    // theta/charm/color_scale for time derivatives, veta takes vega and charm scales).
+    // Columns without a meaning in the model (epsilon, dual_rho and the BSM-specific
+    // higher-order cross Greeks) stay NaN.
+
+    // Black-76: lognormal forward with volatility sigma.
+    struct Black76Model {
+        static constexpr const char* name = "black76";
+        static constexpr GreekMask columns = kAllGreeks & ~(greek_bit(GreekColumn::Epsilon) | greek_bit(GreekColumn::DualRho) |
+                                                            greek_bit(GreekColumn::ZedZeta) | greek_bit(GreekColumn::Crackle) |
+                                                            greek_bit(GreekColumn::Pop) | greek_bit(GreekColumn::Quintema) |
+                                                            greek_bit(GreekColumn::Mixed5th) | greek_bit(GreekColumn::Hexema) |
+                                                            greek_bit(GreekColumn::Mixed6th));
+
+        // F > 0, K > 0, T > 0, sigma > 0 and everything finite.
+        static bool valid(double F, double K, double T, double r, double sigma);
+        static double price(bool call, double F, double K, double T, double r, double sigma);
+        // Fills the requested columns of `g` from one shared evaluation of d1/d2. Snap,
+        // jounce and pounce follow higher_order_enabled like calculate_all.
+        static void evaluate(GreekMask columns, bool call, double F, double K, double T, double r, double sigma,
+                             const ScalingParams& scaling, Greeks& g);
+        // NaN if the price is outside the no-arbitrage bounds or the solve fails.
+        static double implied_volatility(bool call, double F, double K, double T, double r, double price);
+    };
+
+    // Bachelier (normal): arithmetic forward with absolute volatility sigma; F and K may
+    // be zero or negative, as for rates and spreads.
+    struct BachelierModel {
+        static constexpr const char* name = "bachelier";
+        static constexpr GreekMask columns = Black76Model::columns;
+
+        // T > 0, sigma > 0 and everything finite.
+        static bool valid(double F, double K, double T, double r, double sigma);
+        static double price(bool call, double F, double K, double T, double r, double sigma);
+        // Snap, jounce and pounce are always computed: the normal model's spot derivatives
+        // are plain Hermite polynomials in d and do not need the lognormal gating.
+        static void evaluate(GreekMask columns, bool call, double F, double K, double T, double r, double sigma,
+                             const ScalingParams& scaling, Greeks& g);
+        static double implied_volatility(bool call, double F, double K, double T, double r, double price);
+    };
+
+    // batch_evaluate kernel for a model. BatchInputs::S carries the forward and q is ignored.
+    template <typename Model>
+    struct ModelKernel {
+        ScalingParams scaling = ScalingParams::standard();
+
+        bool valid(double F, double K, double T, double r, double sigma, double) const {
+            return Model::valid(F, K, T, r, sigma);
+        }
+        void operator()(GreekMask columns, bool call, double F, double K, double T, double r, double sigma, double, Greeks& g) const {
+            Model::evaluate(columns, call, F, K, T, r, sigma, scaling, g);
+        }
+    };
+
+    // Every Greek of the model in one call; throws std::invalid_argument on invalid inputs.
+    template <typename Model>
+    Greeks model_greeks(bool call, double F, double K, double T, double r, double sigma,
+                        const ScalingParams& scaling = ScalingParams::standard(), GreekMask columns = kAllGreeks) {
+        if (!Model::valid(F, K, T, r, sigma)) {
+            throw std::invalid_argument(std::string("Invalid ") + Model::name + " inputs.");
+        }
+        Greeks g;
+        Model::evaluate(columns & Model::columns, call, F, K, T, r, sigma, scaling, g);
+        return g;
+    }
+
+    // Model counterparts of batch_greeks and batch_implied_volatility, with the same
+    // inputs, outputs, threading and status handling. `in.S` is the forward.
+    template <typename Model>
+    std::size_t model_batch_greeks(const BatchInputs& in, const BatchOutputs& out,
+                                   const ScalingParams& scaling = ScalingParams::standard(), int threads = 0) {
+        return batch_evaluate(in, out, ModelKernel<Model>{scaling}, threads);
+    }
+
+    template <typename Model>
+    std::size_t model_batch_implied_volatility(const BatchInputs& in, StridedView<const double> market_price,
+                                               StridedView<double> out_sigma, StridedView<std::int32_t> status = {},
+                                               int threads = 0) {
+        return detail::for_each_row(in.count, threads, [&](std::size_t i) {
+            bool call = in.call ? in.call[i] != 0 : true;
+            double F = in.S[i], K = in.K[i], T = in.T[i], r = in.r[i];
+            double price = market_price[i];
+            BatchStatus s = BatchStatus::Ok;
+            double iv = std::numeric_limits<double>::quiet_NaN();
+
+            if (!Model::valid(F, K, T, r, 0.1) || !(price > 0.0)) {
+                s = BatchStatus::InvalidInput;
+            } else {
+                iv = Model::implied_volatility(call, F, K, T, r, price);
+                if (!std::isfinite(iv)) {
+                    s = BatchStatus::NoConvergence;
+                }
+            }
+
+            out_sigma[i] = iv;
+            if (status) {
+                status[i] = static_cast<std::int32_t>(s);
+            }
+            return s;
+        }, [&](std::size_t i) {
+            out_sigma[i] = std::numeric_limits<double>::quiet_NaN();
+            if (status) {
+                status[i] = static_cast<std::int32_t>(BatchStatus::Error);
+            }
+        });
+    }
+}
@@ -0,0 +1,60 @@
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace GreeksCalculator {
+    unsigned resolve_thread_count(int threads) {
+        if (threads > 0) {
+            return static_cast<unsigned>(threads);
+        }
+        unsigned hw = std::thread::hardware_concurrency();
+        return hw == 0 ? 1u : hw;
+    }
+
+    void parallel_for(std::size_t tasks, int threads, const std::function<void(std::size_t)>& task) {
+        if (tasks == 0) {
+            return;
+        }
+        std::size_t workers = std::min<std::size_t>(resolve_thread_count(threads), tasks);
+        if (workers <= 1) {
+            for (std::size_t i = 0; i < tasks; ++i) {
+                task(i);
+            }
+            return;
+        }
+
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+        auto worker = [&]() {
+            for (std::size_t i = next.fetch_add(1); i < tasks; i = next.fetch_add(1)) {
+                try {
+                    task(i);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error) {
+                        error = std::current_exception();
+                    }
+                    next.store(tasks);
+                }
+            }
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(workers - 1);
+        for (std::size_t t = 1; t < workers; ++t) {
+            pool.emplace_back(worker);
+        }
+        worker();
+        for (auto& th : pool) {
+            th.join();
+        }
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
@@ -0,0 +1,13 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+namespace GreeksCalculator {
+    // Number of worker threads to use; threads <= 0 selects every available core.
+    unsigned resolve_thread_count(int threads);
+
+    // Runs task(i) for every i in [0, tasks) across up to `threads` workers.
+    // Tasks are handed out dynamically, so callers that need reproducible results
+    // must make each task's output depend only on its index.
+    void parallel_for(std::size_t tasks, int threads, const std::function<void(std::size_t)>& task);
+}
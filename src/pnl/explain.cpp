@@ -0,0 +1,348 @@
+#include "pnl/explain.h"
+#include "bsm/validation.h"
+#include "math/cdf.h"
+#include "math/pdf.h"
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    namespace {
+        struct ExplainGreeks {
+            double price, delta, gamma, vega, theta, vanna, volga;
+        };
+
+        // The unscaled calculate_price/delta/gamma/vega/theta/vanna/volga results, sharing one
+        // d1/d2 and one pair of discount factors: every tick pays for this, so it is fused.
+        ExplainGreeks explain_greeks(bool call, double S, double K, double T, double r, double sigma, double q) {
+            double sqT = std::sqrt(T), v = sigma * sqT;
+            double d1 = (std::log(S / K) + (r - q + 0.5 * sigma * sigma) * T) / v, d2 = d1 - v;
+            double dq = std::exp(-q * T), dr = std::exp(-r * T);
+            double n1 = normal_pdf(d1);
+            double N1 = normal_cdf(call ? d1 : -d1), N2 = normal_cdf(call ? d2 : -d2);
+            double sign = call ? 1.0 : -1.0;
+            ExplainGreeks g;
+            g.price = sign * (S * dq * N1 - K * dr * N2);
+            g.delta = sign * dq * N1;
+            g.gamma = dq * n1 / (S * v);
+            g.vega = S * dq * n1 * sqT;
+            g.theta = -S * dq * n1 * sigma / (2.0 * sqT) + sign * (q * S * dq * N1 - r * K * dr * N2);
+            g.vanna = -dq * n1 * d2 / sigma;
+            g.volga = g.vega * d1 * d2 / sigma;
+            return g;
+        }
+
+        // Positions handed to each parallel task, so small chunks do not drown in scheduling.
+        constexpr std::size_t kPositionsPerTask = 64;
+
+        constexpr std::size_t kReadBuffer = 1u << 20;
+
+        PnlAttribution scaled(const PnlAttribution& a, double quantity) {
+            PnlAttribution s;
+            s.delta = a.delta * quantity;
+            s.gamma = a.gamma * quantity;
+            s.vega = a.vega * quantity;
+            s.theta = a.theta * quantity;
+            s.vanna = a.vanna * quantity;
+            s.volga = a.volga * quantity;
+            s.residual = a.residual * quantity;
+            s.intervals = a.intervals;
+            return s;
+        }
+
+        bool parse_double(const char*& p, double& value) {
+            char* end = nullptr;
+            value = std::strtod(p, &end);
+            if (end == p) {
+                return false;
+            }
+            p = end;
+            return true;
+        }
+    }
+
+    PnlAttribution& PnlAttribution::operator+=(const PnlAttribution& other) {
+        delta += other.delta;
+        gamma += other.gamma;
+        vega += other.vega;
+        theta += other.theta;
+        vanna += other.vanna;
+        volga += other.volga;
+        residual += other.residual;
+        intervals += other.intervals;
+        return *this;
+    }
+
+    PnlExplainer::PnlExplainer(std::vector<PnlPosition> positions, const PnlExplainOptions& options)
+        : positions_(std::move(positions)), state_(positions_.size()), options_(options) {
+        if (!(options_.year > 0.0) || options_.chunk_ticks == 0) {
+            throw std::invalid_argument("Invalid P&L explain options.");
+        }
+        index_.reserve(positions_.size());
+        for (std::size_t i = 0; i < positions_.size(); ++i) {
+            if (!index_.emplace(positions_[i].name, static_cast<std::uint32_t>(i)).second) {
+                throw std::invalid_argument("Duplicate position: " + positions_[i].name);
+            }
+        }
+    }
+
+    long PnlExplainer::find(const std::string& name) const {
+        auto it = index_.find(name);
+        return it == index_.end() ? -1 : static_cast<long>(it->second);
+    }
+
+    bool PnlExplainer::advance(std::size_t index, const PnlTick& tick) {
+        const PnlPosition& p = positions_[index];
+        State& s = state_[index];
+        double T = (p.expiry - tick.timestamp) / options_.year;
+        if (!inputs_valid(tick.S, p.K, T, p.r, tick.sigma, p.q) || (s.live && tick.timestamp < s.timestamp)) {
+            return false;
+        }
+
+        ExplainGreeks g = explain_greeks(p.call, tick.S, p.K, T, p.r, tick.sigma, p.q);
+
+        if (s.live) {
+            double dS = tick.S - s.S;
+            double dsigma = tick.sigma - s.sigma;
+            double dt = (tick.timestamp - s.timestamp) / options_.year;
+            PnlAttribution step;
+            step.delta = s.delta * dS;
+            step.gamma = 0.5 * s.gamma * dS * dS;
+            step.vega = s.vega * dsigma;
+            step.theta = s.theta * dt;
+            step.vanna = s.vanna * dS * dsigma;
+            step.volga = 0.5 * s.volga * dsigma * dsigma;
+            step.residual = (g.price - s.price) - step.total();
+            step.intervals = 1;
+            s.unit += step;
+        }
+
+        s.live = true;
+        s.timestamp = tick.timestamp;
+        s.S = tick.S;
+        s.sigma = tick.sigma;
+        s.price = g.price;
+        s.delta = g.delta;
+        s.gamma = g.gamma;
+        s.vega = g.vega;
+        s.theta = g.theta;
+        s.vanna = g.vanna;
+        s.volga = g.volga;
+        return true;
+    }
+
+    void PnlExplainer::process(const PnlTick* ticks, std::size_t count) {
+        // Counting sort by position keeps each position's ticks in arrival order, and lets
+        // positions run in parallel without sharing state.
+        std::size_t n = positions_.size();
+        offsets_.assign(n + 1, 0);
+        for (std::size_t i = 0; i < count; ++i) {
+            if (ticks[i].position < n) {
+                ++offsets_[ticks[i].position + 1];
+            } else {
+                ++counts_.unknown;
+            }
+        }
+        std::vector<std::uint32_t> active;
+        for (std::size_t p = 0; p < n; ++p) {
+            if (offsets_[p + 1] != 0) {
+                active.push_back(static_cast<std::uint32_t>(p));
+            }
+            offsets_[p + 1] += offsets_[p];
+        }
+        order_.resize(offsets_[n]);
+        {
+            std::vector<std::uint32_t> next(offsets_.begin(), offsets_.end() - 1);
+            for (std::size_t i = 0; i < count; ++i) {
+                if (ticks[i].position < n) {
+                    order_[next[ticks[i].position]++] = static_cast<std::uint32_t>(i);
+                }
+            }
+        }
+
+        std::atomic<std::uint64_t> accepted{0}, rejected{0};
+        std::size_t tasks = (active.size() + kPositionsPerTask - 1) / kPositionsPerTask;
+        parallel_for(tasks, options_.threads, [&](std::size_t t) {
+            std::size_t begin = t * kPositionsPerTask;
+            std::size_t end = std::min(active.size(), begin + kPositionsPerTask);
+            std::uint64_t ok = 0, bad = 0;
+            for (std::size_t a = begin; a < end; ++a) {
+                std::uint32_t p = active[a];
+                for (std::uint32_t j = offsets_[p]; j < offsets_[p + 1]; ++j) {
+                    if (advance(p, ticks[order_[j]])) {
+                        ++ok;
+                    } else {
+                        ++bad;
+                    }
+                }
+            }
+            accepted.fetch_add(ok, std::memory_order_relaxed);
+            rejected.fetch_add(bad, std::memory_order_relaxed);
+        });
+        counts_.ticks += accepted.load();
+        counts_.rejected += rejected.load();
+    }
+
+    void PnlExplainer::process_file(const std::string& path) {
+        std::unique_ptr<std::FILE, int (*)(std::FILE*)> file(std::fopen(path.c_str(), "rb"), &std::fclose);
+        if (!file) {
+            throw std::runtime_error("Cannot open tick file: " + path);
+        }
+
+        std::vector<PnlTick> chunk;
+        chunk.reserve(options_.chunk_ticks);
+        std::vector<char> buffer(kReadBuffer + 1);
+        std::string name;
+        std::size_t held = 0;
+        bool skipping = false;      // Inside a line too long for the buffer
+
+        auto parse_line = [&](char* line, char* line_end) {
+            *line_end = '\0';
+            while (line < line_end && (*line == ' ' || *line == '\t' || *line == '\r')) {
+                ++line;
+            }
+            if (line == line_end || *line == '#') {
+                return;
+            }
+            const char* p = line;
+            PnlTick tick;
+            double S = 0.0, sigma = 0.0;
+            const char* comma = nullptr;
+            bool ok = parse_double(p, tick.timestamp) && *p++ == ',' &&
+                      (comma = static_cast<const char*>(std::memchr(p, ',', static_cast<std::size_t>(line_end - p)))) != nullptr;
+            if (ok) {
+                name.assign(p, comma);
+                p = comma + 1;
+                ok = parse_double(p, S) && *p++ == ',' && parse_double(p, sigma);
+                while (ok && p < line_end && (*p == ' ' || *p == '\t' || *p == '\r')) {
+                    ++p;
+                }
+                ok = ok && p == line_end;
+            }
+            if (!ok) {
+                ++counts_.malformed;
+                return;
+            }
+            auto it = index_.find(name);
+            if (it == index_.end()) {
+                ++counts_.unknown;
+                return;
+            }
+            tick.position = it->second;
+            tick.S = S;
+            tick.sigma = sigma;
+            chunk.push_back(tick);
+            if (chunk.size() == options_.chunk_ticks) {
+                process(chunk.data(), chunk.size());
+                chunk.clear();
+            }
+        };
+
+        for (;;) {
+            std::size_t read = std::fread(buffer.data() + held, 1, kReadBuffer - held, file.get());
+            bool eof = read < kReadBuffer - held;
+            if (eof && std::ferror(file.get())) {
+                throw std::runtime_error("Failed reading tick file: " + path);
+            }
+            std::size_t size = held + read;
+            char* begin = buffer.data();
+            char* end = begin + size;
+            for (;;) {
+                char* newline = static_cast<char*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+                if (!newline) {
+                    break;
+                }
+                if (skipping) {
+                    skipping = false;
+                } else {
+                    parse_line(begin, newline);
+                }
+                begin = newline + 1;
+            }
+            held = static_cast<std::size_t>(end - begin);
+            if (eof) {
+                if (held > 0 && !skipping) {
+                    parse_line(begin, end);
+                }
+                break;
+            }
+            if (held == kReadBuffer) {
+                ++counts_.malformed;
+                skipping = true;
+                held = 0;
+            } else {
+                std::memmove(buffer.data(), begin, held);
+            }
+        }
+        if (!chunk.empty()) {
+            process(chunk.data(), chunk.size());
+        }
+    }
+
+    PnlAttribution PnlExplainer::position(std::size_t index) const {
+        return scaled(state_.at(index).unit, positions_[index].quantity);
+    }
+
+    std::vector<std::pair<std::string, PnlAttribution>> PnlExplainer::by_underlying() const {
+        std::map<std::string, PnlAttribution> totals;
+        for (std::size_t i = 0; i < positions_.size(); ++i) {
+            totals[positions_[i].underlying] += position(i);
+        }
+        return {totals.begin(), totals.end()};
+    }
+
+    PnlAttribution PnlExplainer::total() const {
+        PnlAttribution sum;
+        for (std::size_t i = 0; i < positions_.size(); ++i) {
+            sum += position(i);
+        }
+        return sum;
+    }
+
+    std::vector<PnlPosition> read_pnl_positions(const std::string& path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Cannot open positions file: " + path);
+        }
+        std::vector<PnlPosition> positions;
+        std::string line;
+        for (std::size_t number = 1; std::getline(file, line); ++number) {
+            if (line.empty() || line[0] == '#' || line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;
+            }
+            std::stringstream fields(line);
+            std::string field[8];
+            int n = 0;
+            while (n < 8 && std::getline(fields, field[n], ',')) {
+                ++n;
+            }
+            PnlPosition p;
+            try {
+                if (n != 8 || (field[2] != "call" && field[2] != "put")) {
+                    throw std::invalid_argument("fields");
+                }
+                p.name = field[0];
+                p.underlying = field[1];
+                p.call = field[2] == "call";
+                p.K = std::stod(field[3]);
+                p.expiry = std::stod(field[4]);
+                p.r = std::stod(field[5]);
+                p.q = std::stod(field[6]);
+                p.quantity = std::stod(field[7]);
+            } catch (const std::exception&) {
+                throw std::runtime_error("Malformed position at " + path + ":" + std::to_string(number));
+            }
+            positions.push_back(std::move(p));
+        }
+        return positions;
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+#include "Greeks.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace GreeksCalculator {
+    // One option line of the book. `name` is the contract identifier used in the tick file;
+    // `expiry` is in the same time unit as the tick timestamps.
+    struct PnlPosition {
+        std::string name;
+        std::string underlying;
+        bool call = true;
+        double K = 0.0;
+        double expiry = 0.0;
+        double r = 0.0;
+        double q = 0.0;
+        double quantity = 0.0;
+    };
+
+    // Taylor attribution of the change in value over each tick interval, using the Greeks
+    // at the start of the interval: delta dS, gamma dS^2 / 2, vega dsigma, theta dt,
+    // vanna dS dsigma and volga dsigma^2 / 2. The residual is what they leave unexplained,
+    // so total() is the actual P&L.
+    struct PnlAttribution {
+        double delta = 0.0;
+        double gamma = 0.0;
+        double vega = 0.0;
+        double theta = 0.0;
+        double vanna = 0.0;
+        double volga = 0.0;
+        double residual = 0.0;
+        std::uint64_t intervals = 0;
+
+        double total() const { return delta + gamma + vega + theta + vanna + volga + residual; }
+        PnlAttribution& operator+=(const PnlAttribution& other);
+    };
+
+    struct PnlTick {
+        double timestamp = 0.0;
+        std::uint32_t position = 0;     // Index into the explainer's positions
+        double S = 0.0;
+        double sigma = 0.0;
+    };
+
+    struct PnlExplainOptions {
+        double year = 365.0 * 86400.0;      // Timestamp units per year; the default reads seconds
+        std::size_t chunk_ticks = 1u << 16; // Ticks parsed and attributed per pass over the book state
+        int threads = 0;                    // 0 = all available cores; results do not depend on this
+    };
+
+    struct PnlExplainCounts {
+        std::uint64_t ticks = 0;            // Ticks attributed (including each position's first)
+        std::uint64_t unknown = 0;          // Contract not in the book
+        std::uint64_t rejected = 0;         // Invalid inputs, expired, or older than the previous tick
+        std::uint64_t malformed = 0;        // Lines of a tick file that did not parse
+    };
+
+    // Streaming P&L explain. Each position keeps the Greeks of its last tick, so every new
+    // tick costs one evaluation and the attribution buckets are updated in place: memory is
+    // the book state plus one chunk of ticks, whatever the length of the history.
+    class PnlExplainer {
+    public:
+        explicit PnlExplainer(std::vector<PnlPosition> positions, const PnlExplainOptions& options = PnlExplainOptions{});
+
+        // Index of the named position, or -1.
+        long find(const std::string& name) const;
+
+        // Attributes a batch of ticks. Ticks must be in time order per position; across
+        // positions the batch may interleave freely. Positions are processed in parallel.
+        void process(const PnlTick* ticks, std::size_t count);
+
+        // Streams a text file of `timestamp,contract,S,implied_vol` lines (blank lines and
+        // lines starting with '#' are skipped) through process() in chunks of
+        // options.chunk_ticks. Throws std::runtime_error if the file cannot be read.
+        void process_file(const std::string& path);
+
+        const std::vector<PnlPosition>& positions() const { return positions_; }
+        PnlAttribution position(std::size_t index) const;                       // Scaled by quantity
+        std::vector<std::pair<std::string, PnlAttribution>> by_underlying() const; // Sorted by name
+        PnlAttribution total() const;
+        const PnlExplainCounts& counts() const { return counts_; }
+
+    private:
+        struct State {
+            bool live = false;
+            double timestamp, S, sigma;
+            double price, delta, gamma, vega, theta, vanna, volga;
+            PnlAttribution unit;        // Attribution of one contract
+        };
+
+        bool advance(std::size_t index, const PnlTick& tick);
+
+        std::vector<PnlPosition> positions_;
+        std::unordered_map<std::string, std::uint32_t> index_;
+        std::vector<State> state_;
+        PnlExplainOptions options_;
+        PnlExplainCounts counts_;
+        std::vector<std::uint32_t> order_, offsets_;    // Per-chunk scratch, reused across chunks
+    };
+
+    // Reads `name,underlying,call|put,K,expiry,r,q,quantity` lines ('#' comments allowed).
+    // Throws std::runtime_error on an unreadable file or a malformed line.
+    std::vector<PnlPosition> read_pnl_positions(const std::string& path);
+}
@@ -0,0 +1,77 @@
+#include "publish/publisher.h"
+#include "publish/seqlock.h"
+#include <bitset>
+#include <cstring>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    namespace {
+        std::uint64_t to_bits(double x) {
+            std::uint64_t b;
+            std::memcpy(&b, &x, sizeof(b));
+            return b;
+        }
+
+        double from_bits(std::uint64_t b) {
+            double x;
+            std::memcpy(&x, &b, sizeof(x));
+            return x;
+        }
+    }
+
+    GreekPublisher::GreekPublisher(const std::vector<std::uint64_t>& contracts, GreekMask columns)
+        : columns_(columns & kAllGreeks),
+          width_(std::bitset<64>(columns_).count()),
+          slots_(contracts.size()),
+          lines_per_slot_((width_ + 2 + kLineWords - 1) / kLineWords),
+          lines_(contracts.size() * lines_per_slot_) {
+        if (width_ == 0) {
+            throw std::invalid_argument("GreekPublisher needs at least one column.");
+        }
+        index_.reserve(contracts.size());
+        for (std::size_t i = 0; i < contracts.size(); ++i) {
+            if (!index_.emplace(contracts[i], static_cast<std::uint32_t>(i)).second) {
+                throw std::invalid_argument("Duplicate contract id in GreekPublisher.");
+            }
+        }
+    }
+
+    long GreekPublisher::slot(std::uint64_t contract) const {
+        auto it = index_.find(contract);
+        return it == index_.end() ? -1 : static_cast<long>(it->second);
+    }
+
+    void GreekPublisher::publish(std::size_t slot, const Greeks& g, double timestamp) {
+        double values[kGreekColumnCount];
+        pack_greeks(columns_, g, values);
+        seqlock::write(words(slot), to_bits(timestamp), values, width_);
+    }
+
+    void GreekPublisher::publish(std::size_t slot, const double* values, double timestamp) {
+        seqlock::write(words(slot), to_bits(timestamp), values, width_);
+    }
+
+    bool GreekPublisher::read(std::size_t slot, Greeks& out, double* timestamp) const {
+        double values[kGreekColumnCount];
+        if (!read(slot, values, timestamp)) {
+            return false;
+        }
+        unpack_greeks(columns_, values, out);
+        return true;
+    }
+
+    bool GreekPublisher::read(std::size_t slot, double* values, double* timestamp) const {
+        std::uint64_t stamp;
+        if (!seqlock::read(words(slot), stamp, values, width_)) {
+            return false;
+        }
+        if (timestamp) {
+            *timestamp = from_bits(stamp);
+        }
+        return true;
+    }
+
+    std::uint64_t GreekPublisher::version(std::size_t slot) const {
+        return seqlock::version(words(slot));
+    }
+}
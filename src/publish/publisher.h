@@ -0,0 +1,63 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/columns.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace GreeksCalculator {
+    // Publishes the latest Greeks of each contract to any number of reader threads with
+    // seqlock versioning. Each contract owns whole cache lines holding a sequence number,
+    // the publication timestamp and the selected columns, so neighbouring contracts never
+    // share a line. Publishing never waits, and reading never takes a lock: a reader that
+    // overlaps a publication retries until it sees a consistent copy.
+    //
+    // Publications to one contract must come from one thread at a time (or be serialized
+    // by the caller); different contracts may be published from different threads.
+    class GreekPublisher {
+    public:
+        // `contracts` are the caller's contract ids; slot i belongs to contracts[i].
+        // Throws std::invalid_argument on a repeated id or an empty column set.
+        explicit GreekPublisher(const std::vector<std::uint64_t>& contracts, GreekMask columns = kAllGreeks);
+
+        GreekPublisher(const GreekPublisher&) = delete;
+        GreekPublisher& operator=(const GreekPublisher&) = delete;
+
+        long slot(std::uint64_t contract) const;                // -1 if unknown
+        std::size_t size() const { return slots_; }
+        GreekMask columns() const { return columns_; }
+        std::size_t width() const { return width_; }            // Values per slot
+
+        // Stores the selected columns of `g` (or `width()` packed values, in column order).
+        void publish(std::size_t slot, const Greeks& g, double timestamp);
+        void publish(std::size_t slot, const double* values, double timestamp);
+
+        // Copies the latest publication of the slot. Only the selected columns of `out`
+        // are written. False if nothing has been published to the slot yet.
+        bool read(std::size_t slot, Greeks& out, double* timestamp = nullptr) const;
+        bool read(std::size_t slot, double* values, double* timestamp = nullptr) const;
+
+        // Number of publications to the slot so far.
+        std::uint64_t version(std::size_t slot) const;
+
+    private:
+        static constexpr std::size_t kLineWords = 8;
+        struct alignas(64) Line {
+            std::atomic<std::uint64_t> word[kLineWords];
+        };
+
+        // A seqlock record (publish/seqlock.h) stamped with the timestamp.
+        std::atomic<std::uint64_t>* words(std::size_t slot) const {
+            return lines_[slot * lines_per_slot_].word;
+        }
+
+        GreekMask columns_;
+        std::size_t width_;
+        std::size_t slots_;
+        std::size_t lines_per_slot_;
+        mutable std::vector<Line> lines_;
+        std::unordered_map<std::uint64_t, std::uint32_t> index_;
+    };
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+namespace GreeksCalculator {
+    // Seqlock record over plain 64-bit atomics: word 0 is the sequence number (odd while a
+    // write is in progress, 0 before the first one), word 1 a caller-defined stamp, then
+    // `n` doubles. The words are lock-free and address-free, so a record may live in
+    // memory shared between processes. One writer per record at a time.
+    namespace seqlock {
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "seqlock records need lock-free 64-bit atomics");
+
+        constexpr std::size_t kHeaderWords = 2;
+        constexpr unsigned kSpinsBeforeYield = 64;
+
+        inline void write(std::atomic<std::uint64_t>* w, std::uint64_t stamp, const double* values, std::size_t n) {
+            std::uint64_t seq = w[0].load(std::memory_order_relaxed);
+            w[0].store(seq + 1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            w[1].store(stamp, std::memory_order_relaxed);
+            for (std::size_t k = 0; k < n; ++k) {
+                std::uint64_t bits;
+                std::memcpy(&bits, &values[k], sizeof(bits));
+                w[kHeaderWords + k].store(bits, std::memory_order_relaxed);
+            }
+            w[0].store(seq + 2, std::memory_order_release);
+        }
+
+        // Copies a consistent record; false if it has never been written.
+        inline bool read(const std::atomic<std::uint64_t>* w, std::uint64_t& stamp, double* values, std::size_t n) {
+            for (unsigned attempt = 1;; ++attempt) {
+                // A writer preempted mid-write would otherwise make readers on the same
+                // core spin for a whole time slice.
+                if (attempt % kSpinsBeforeYield == 0) {
+                    std::this_thread::yield();
+                }
+                std::uint64_t before = w[0].load(std::memory_order_acquire);
+                if (before == 0) {
+                    return false;
+                }
+                if (before & 1) {
+                    continue;
+                }
+                std::uint64_t s = w[1].load(std::memory_order_relaxed);
+                for (std::size_t k = 0; k < n; ++k) {
+                    std::uint64_t bits = w[kHeaderWords + k].load(std::memory_order_relaxed);
+                    std::memcpy(&values[k], &bits, sizeof(bits));
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (w[0].load(std::memory_order_relaxed) == before) {
+                    stamp = s;
+                    return true;
+                }
+            }
+        }
+
+        // Completed writes so far.
+        inline std::uint64_t version(const std::atomic<std::uint64_t>* w) {
+            return w[0].load(std::memory_order_acquire) / 2;
+        }
+    }
+}
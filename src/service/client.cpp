@@ -0,0 +1,115 @@
+#include "service/client.h"
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace GreeksCalculator {
+    PricingClient::PricingClient(const std::string& socket_path) {
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (socket_path.size() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error("Socket path too long: " + socket_path);
+        }
+        std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd_ < 0 || ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::string err = std::strerror(errno);
+            if (fd_ >= 0) {
+                ::close(fd_);
+            }
+            throw std::runtime_error("Cannot connect to " + socket_path + ": " + err);
+        }
+    }
+
+    PricingClient::~PricingClient() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    std::uint32_t PricingClient::send(MessageType type, GreekMask columns, const std::vector<WireContract>& contracts) {
+        std::uint32_t id = next_id_++;
+        frame_.clear();
+        if (type == MessageType::StatsRequest) {
+            encode_text(frame_, type, id, "");
+        } else {
+            encode_request(frame_, type, id, columns, contracts.data(), contracts.size());
+        }
+
+        const std::uint8_t* p = frame_.data();
+        std::size_t left = frame_.size();
+        while (left > 0) {
+            ssize_t n = ::send(fd_, p, left, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Pricing service connection lost");
+            }
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+        return id;
+    }
+
+    std::uint32_t PricingClient::send_greeks(GreekMask columns, const std::vector<WireContract>& contracts) {
+        return send(MessageType::GreeksRequest, columns, contracts);
+    }
+
+    std::uint32_t PricingClient::send_implied_vol(const std::vector<WireContract>& contracts) {
+        return send(MessageType::ImpliedVolRequest, 0, contracts);
+    }
+
+    std::uint32_t PricingClient::send_stats() {
+        return send(MessageType::StatsRequest, 0, {});
+    }
+
+    void PricingClient::read_exact(std::uint8_t* out, std::size_t size) {
+        while (size > 0) {
+            ssize_t n = ::recv(fd_, out, size, 0);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                throw std::runtime_error("Pricing service connection lost");
+            }
+            out += n;
+            size -= static_cast<std::size_t>(n);
+        }
+    }
+
+    ServiceReply PricingClient::receive() {
+        FrameHeader h;
+        read_exact(reinterpret_cast<std::uint8_t*>(&h), sizeof(h));
+        if (!header_valid(h)) {
+            throw std::runtime_error("Malformed frame from pricing service");
+        }
+        std::vector<std::uint8_t> payload(h.payload_bytes);
+        read_exact(payload.data(), payload.size());
+
+        ServiceReply reply;
+        if (!decode_reply(h, payload.data(), reply)) {
+            throw std::runtime_error("Malformed reply from pricing service");
+        }
+        return reply;
+    }
+
+    ServiceReply PricingClient::greeks(GreekMask columns, const std::vector<WireContract>& contracts) {
+        send_greeks(columns, contracts);
+        return receive();
+    }
+
+    ServiceReply PricingClient::implied_vol(const std::vector<WireContract>& contracts) {
+        send_implied_vol(contracts);
+        return receive();
+    }
+
+    std::string PricingClient::stats() {
+        send_stats();
+        return receive().text;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include "service/protocol.h"
+#include <string>
+#include <vector>
+
+namespace GreeksCalculator {
+    // Blocking client for PricingServer. send_* calls may be pipelined; receive()
+    // returns replies in the order the server finishes them, matched by request_id.
+    class PricingClient {
+    public:
+        explicit PricingClient(const std::string& socket_path);   // Throws std::runtime_error
+        ~PricingClient();
+
+        PricingClient(const PricingClient&) = delete;
+        PricingClient& operator=(const PricingClient&) = delete;
+
+        std::uint32_t send_greeks(GreekMask columns, const std::vector<WireContract>& contracts);
+        std::uint32_t send_implied_vol(const std::vector<WireContract>& contracts);
+        std::uint32_t send_stats();
+        ServiceReply receive();
+
+        // Convenience round trips; only valid with no other requests outstanding.
+        ServiceReply greeks(GreekMask columns, const std::vector<WireContract>& contracts);
+        ServiceReply implied_vol(const std::vector<WireContract>& contracts);
+        std::string stats();
+
+    private:
+        std::uint32_t send(MessageType type, GreekMask columns, const std::vector<WireContract>& contracts);
+        void read_exact(std::uint8_t* out, std::size_t size);
+
+        int fd_ = -1;
+        std::uint32_t next_id_ = 1;
+        std::vector<std::uint8_t> frame_;
+    };
+}
@@ -0,0 +1,81 @@
+#include "service/metrics.h"
+#include <cmath>
+#include <cstdio>
+
+namespace GreeksCalculator {
+    namespace {
+        int bucket_of(std::uint64_t ns) {
+            if (ns < 4) {
+                return static_cast<int>(ns);
+            }
+            int msb = 63 - __builtin_clzll(ns);
+            int sub = static_cast<int>((ns >> (msb - 2)) & 3);
+            return msb * 4 + sub;
+        }
+
+        double bucket_upper_us(int bucket) {
+            if (bucket < 4) {
+                return (bucket + 1) / 1000.0;
+            }
+            // Bucket 4*msb + sub spans [2^msb * (4 + sub) / 4, 2^msb * (5 + sub) / 4).
+            return std::ldexp(5.0 + bucket % 4, bucket / 4 - 2) / 1000.0;
+        }
+    }
+
+    void LatencyHistogram::record(std::chrono::nanoseconds elapsed) {
+        std::uint64_t ns = elapsed.count() > 0 ? static_cast<std::uint64_t>(elapsed.count()) : 0;
+        buckets_[bucket_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        total_ns_.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t prev = max_ns_.load(std::memory_order_relaxed);
+        while (ns > prev && !max_ns_.compare_exchange_weak(prev, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    LatencyHistogram::Summary LatencyHistogram::summary() const {
+        Summary s;
+        s.count = count_.load(std::memory_order_relaxed);
+        if (s.count == 0) {
+            return s;
+        }
+        s.mean_us = total_ns_.load(std::memory_order_relaxed) / 1000.0 / s.count;
+        s.max_us = max_ns_.load(std::memory_order_relaxed) / 1000.0;
+
+        std::uint64_t p50 = (s.count + 1) / 2, p99 = (s.count * 99 + 99) / 100, seen = 0;
+        for (int b = 0; b < kBuckets; ++b) {
+            std::uint64_t n = buckets_[b].load(std::memory_order_relaxed);
+            if (n == 0) {
+                continue;
+            }
+            if (seen < p50 && seen + n >= p50) {
+                s.p50_us = bucket_upper_us(b);
+            }
+            if (seen < p99 && seen + n >= p99) {
+                s.p99_us = bucket_upper_us(b);
+            }
+            seen += n;
+        }
+        return s;
+    }
+
+    std::string ServiceMetrics::report() const {
+        std::string out;
+        char line[256];
+        std::snprintf(line, sizeof(line), "requests=%llu contracts=%llu coalesced=%llu batches=%llu avg_batch=%.1f dropped=%llu\n",
+                      static_cast<unsigned long long>(requests.load()), static_cast<unsigned long long>(contracts.load()),
+                      static_cast<unsigned long long>(coalesced.load()), static_cast<unsigned long long>(batches.load()),
+                      batches.load() ? static_cast<double>(batched_rows.load()) / batches.load() : 0.0,
+                      static_cast<unsigned long long>(dropped.load()));
+        out += line;
+
+        const std::pair<const char*, const LatencyHistogram*> stages[] = {
+            {"queue", &queue}, {"compute", &compute}, {"reply", &reply}, {"end_to_end", &end_to_end}};
+        for (const auto& stage : stages) {
+            LatencyHistogram::Summary s = stage.second->summary();
+            std::snprintf(line, sizeof(line), "%-10s count=%llu mean=%.1fus p50=%.1fus p99=%.1fus max=%.1fus\n",
+                          stage.first, static_cast<unsigned long long>(s.count), s.mean_us, s.p50_us, s.p99_us, s.max_us);
+            out += line;
+        }
+        return out;
+    }
+}
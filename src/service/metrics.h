@@ -0,0 +1,47 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+namespace GreeksCalculator {
+    // Lock-free latency histogram with four sub-buckets per power of two of
+    // nanoseconds, so reported percentiles are within ~19% of the true value.
+    class LatencyHistogram {
+    public:
+        struct Summary {
+            std::uint64_t count = 0;
+            double mean_us = 0.0;
+            double p50_us = 0.0;
+            double p99_us = 0.0;
+            double max_us = 0.0;
+        };
+
+        void record(std::chrono::nanoseconds elapsed);
+        Summary summary() const;
+
+    private:
+        static constexpr int kBuckets = 64 * 4;
+        std::array<std::atomic<std::uint64_t>, kBuckets> buckets_{};
+        std::atomic<std::uint64_t> count_{0};
+        std::atomic<std::uint64_t> total_ns_{0};
+        std::atomic<std::uint64_t> max_ns_{0};
+    };
+
+    struct ServiceMetrics {
+        LatencyHistogram queue;        // Request received -> contract dispatched in a batch
+        LatencyHistogram compute;      // Batch engine run time
+        LatencyHistogram reply;        // Last contract computed -> response handed to the socket or queued
+        LatencyHistogram end_to_end;   // Request received -> response handed to the socket or queued
+
+        std::atomic<std::uint64_t> requests{0};
+        std::atomic<std::uint64_t> contracts{0};
+        std::atomic<std::uint64_t> coalesced{0};   // Contracts served by an already pending computation
+        std::atomic<std::uint64_t> batches{0};
+        std::atomic<std::uint64_t> batched_rows{0};
+        std::atomic<std::uint64_t> dropped{0};      // Clients disconnected for a full outbox
+
+        std::string report() const;
+    };
+}
@@ -0,0 +1,82 @@
+#include "service/protocol.h"
+#include <bitset>
+#include <cstring>
+
+namespace GreeksCalculator {
+    namespace {
+        template <typename T>
+        void append(std::vector<std::uint8_t>& out, const T& value) {
+            const auto* p = reinterpret_cast<const std::uint8_t*>(&value);
+            out.insert(out.end(), p, p + sizeof(T));
+        }
+
+        void append_header(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t request_id, std::size_t payload) {
+            FrameHeader h;
+            h.type = static_cast<std::uint16_t>(type);
+            h.request_id = request_id;
+            h.payload_bytes = static_cast<std::uint32_t>(payload);
+            append(out, h);
+        }
+    }
+
+    std::size_t column_count(GreekMask columns) {
+        return std::bitset<64>(columns & kAllGreeks).count();
+    }
+
+    bool header_valid(const FrameHeader& header) {
+        return header.magic == kFrameMagic && header.version == kProtocolVersion && header.payload_bytes <= kMaxPayloadBytes;
+    }
+
+    void encode_request(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t request_id, GreekMask columns,
+                        const WireContract* contracts, std::size_t count) {
+        RequestPrefix prefix;
+        prefix.columns = columns;
+        prefix.count = static_cast<std::uint32_t>(count);
+        append_header(out, type, request_id, sizeof(prefix) + count * sizeof(WireContract));
+        append(out, prefix);
+        const auto* p = reinterpret_cast<const std::uint8_t*>(contracts);
+        out.insert(out.end(), p, p + count * sizeof(WireContract));
+    }
+
+    void encode_text(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t request_id, const std::string& text) {
+        append_header(out, type, request_id, text.size());
+        out.insert(out.end(), text.begin(), text.end());
+    }
+
+    bool decode_reply(const FrameHeader& header, const std::uint8_t* payload, ServiceReply& reply) {
+        reply = ServiceReply{};
+        reply.type = static_cast<MessageType>(header.type);
+        reply.request_id = header.request_id;
+
+        if (reply.type == MessageType::StatsResponse || reply.type == MessageType::ErrorResponse) {
+            reply.text.assign(reinterpret_cast<const char*>(payload), header.payload_bytes);
+            return true;
+        }
+        if (reply.type != MessageType::GreeksResponse && reply.type != MessageType::ImpliedVolResponse) {
+            return false;
+        }
+        if (header.payload_bytes < sizeof(RequestPrefix)) {
+            return false;
+        }
+
+        RequestPrefix prefix;
+        std::memcpy(&prefix, payload, sizeof(prefix));
+        std::size_t width = reply.type == MessageType::GreeksResponse ? column_count(prefix.columns) : 1;
+        std::size_t row_bytes = sizeof(WireStatus) + width * sizeof(double);
+        if (header.payload_bytes != sizeof(prefix) + prefix.count * row_bytes) {
+            return false;
+        }
+
+        reply.columns = prefix.columns;
+        reply.status.resize(prefix.count);
+        reply.values.resize(prefix.count * width);
+        const std::uint8_t* row = payload + sizeof(prefix);
+        for (std::uint32_t i = 0; i < prefix.count; ++i, row += row_bytes) {
+            WireStatus s;
+            std::memcpy(&s, row, sizeof(s));
+            reply.status[i] = s.status;
+            std::memcpy(reply.values.data() + i * width, row + sizeof(s), width * sizeof(double));
+        }
+        return true;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "batch/columns.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace GreeksCalculator {
+    // Wire format of the local pricing service. Peers share a host, so integers
+    // and doubles travel in native byte order. Every frame is a FrameHeader
+    // followed by `payload_bytes` of payload.
+    constexpr std::uint32_t kFrameMagic = 0x4751514F;   // "OQQG"
+    constexpr std::uint16_t kProtocolVersion = 1;
+    constexpr std::uint32_t kMaxPayloadBytes = 64u << 20;
+
+    enum class MessageType : std::uint16_t {
+        GreeksRequest = 1,        // RequestPrefix + count x WireContract (sigma = volatility)
+        ImpliedVolRequest = 2,    // RequestPrefix + count x WireContract (sigma = market price)
+        StatsRequest = 3,         // Empty payload
+        GreeksResponse = 101,     // RequestPrefix + count x (WireStatus + popcount(columns) doubles)
+        ImpliedVolResponse = 102, // RequestPrefix + count x (WireStatus + 1 double)
+        StatsResponse = 103,      // Plain text
+        ErrorResponse = 199,      // Plain text
+    };
+
+    struct FrameHeader {
+        std::uint32_t magic = kFrameMagic;
+        std::uint16_t type = 0;
+        std::uint16_t version = kProtocolVersion;
+        std::uint32_t request_id = 0;
+        std::uint32_t payload_bytes = 0;
+    };
+
+    struct RequestPrefix {
+        GreekMask columns = 0;    // Unused for implied volatility
+        std::uint32_t count = 0;
+        std::uint32_t reserved = 0;
+    };
+
+    struct WireContract {
+        double S = 0.0;
+        double K = 0.0;
+        double T = 0.0;
+        double r = 0.0;
+        double sigma = 0.0;       // Market price in ImpliedVolRequest
+        double q = 0.0;
+        std::uint8_t call = 1;
+        std::uint8_t reserved[7] = {};
+    };
+
+    struct WireStatus {
+        std::int32_t status = 0;  // BatchStatus
+        std::int32_t reserved = 0;
+    };
+
+    static_assert(sizeof(FrameHeader) == 16, "FrameHeader layout");
+    static_assert(sizeof(RequestPrefix) == 16, "RequestPrefix layout");
+    static_assert(sizeof(WireContract) == 56, "WireContract layout");
+    static_assert(sizeof(WireStatus) == 8, "WireStatus layout");
+
+    // Decoded response, as returned by PricingClient.
+    struct ServiceReply {
+        MessageType type = MessageType::ErrorResponse;
+        std::uint32_t request_id = 0;
+        GreekMask columns = 0;
+        std::vector<std::int32_t> status;
+        std::vector<double> values;   // Row-major: count x (popcount(columns), or 1 for implied vol)
+        std::string text;             // Stats and error responses
+    };
+
+    std::size_t column_count(GreekMask columns);
+
+    // Appends a complete frame (header + payload) to `out`.
+    void encode_request(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t request_id, GreekMask columns,
+                        const WireContract* contracts, std::size_t count);
+    void encode_text(std::vector<std::uint8_t>& out, MessageType type, std::uint32_t request_id, const std::string& text);
+
+    // Returns false on a malformed frame.
+    bool decode_reply(const FrameHeader& header, const std::uint8_t* payload, ServiceReply& reply);
+    bool header_valid(const FrameHeader& header);
+}
@@ -0,0 +1,627 @@
+#include "service/server.h"
+#include "batch/batch.h"
+#include "service/protocol.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace GreeksCalculator {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        struct Connection {
+            int fd = -1;
+            std::mutex write_mutex;
+            std::vector<std::uint8_t> outbox;   // Encoded replies the socket has not taken yet
+            std::size_t sent = 0;               // Leading bytes of outbox already written
+            bool broken = false;                // Write error or outbox overflow; the I/O thread closes it
+            std::vector<std::uint8_t> inbox;
+
+            std::size_t unsent() const { return outbox.size() - sent; }
+        };
+        using ConnectionPtr = std::shared_ptr<Connection>;
+
+        struct Job {
+            ConnectionPtr conn;
+            MessageType type = MessageType::GreeksRequest;
+            std::uint32_t request_id = 0;
+            GreekMask columns = 0;
+            std::size_t width = 0;
+            Clock::time_point received;
+            std::vector<std::int32_t> status;
+            std::vector<double> values;
+            std::atomic<std::size_t> remaining{0};
+        };
+        using JobPtr = std::shared_ptr<Job>;
+
+        // Identity of a pending computation: the contract bits plus the request kind.
+        struct ContractKey {
+            std::uint64_t words[8] = {};
+
+            bool operator==(const ContractKey& o) const { return std::memcmp(words, o.words, sizeof(words)) == 0; }
+        };
+
+        struct ContractKeyHash {
+            std::size_t operator()(const ContractKey& k) const {
+                std::uint64_t h = 1469598103934665603ull;
+                for (std::uint64_t w : k.words) {
+                    h = (h ^ w) * 1099511628211ull;
+                }
+                return static_cast<std::size_t>(h ^ (h >> 29));
+            }
+        };
+
+        struct Waiter {
+            JobPtr job;
+            std::uint32_t row;
+        };
+
+        struct Entry {
+            ContractKey key;
+            WireContract contract;
+            bool implied_vol = false;
+            GreekMask columns = 0;
+            bool dispatched = false;
+            Clock::time_point enqueued;
+            std::vector<Waiter> waiters;
+            std::int32_t status = 0;
+            double values[kGreekColumnCount] = {};
+        };
+        using EntryPtr = std::shared_ptr<Entry>;
+
+        ContractKey make_key(const WireContract& c, bool implied_vol) {
+            ContractKey k;
+            double fields[6] = {c.S, c.K, c.T, c.r, c.sigma, c.q};
+            std::memcpy(k.words, fields, sizeof(fields));
+            k.words[6] = c.call != 0;
+            k.words[7] = implied_vol;
+            return k;
+        }
+
+        void set_nonblocking(int fd) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+        }
+
+        // Writes as much of the outbox as the socket takes without blocking; the caller
+        // holds write_mutex. Returns false on a socket error.
+        bool flush(Connection& c) {
+            while (c.unsent() > 0) {
+                ssize_t n = ::send(c.fd, c.outbox.data() + c.sent, c.unsent(), MSG_NOSIGNAL);
+                if (n > 0) {
+                    c.sent += static_cast<std::size_t>(n);
+                } else if (n < 0 && errno == EINTR) {
+                    continue;
+                } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                    break;
+                } else {
+                    return false;
+                }
+            }
+            if (c.unsent() == 0) {
+                c.outbox.clear();
+                c.sent = 0;
+            } else if (c.sent > c.outbox.size() / 2) {
+                c.outbox.erase(c.outbox.begin(), c.outbox.begin() + static_cast<std::ptrdiff_t>(c.sent));
+                c.sent = 0;
+            }
+            return true;
+        }
+    }
+
+    struct PricingServer::Impl {
+        ServiceConfig config;
+        ServiceMetrics metrics;
+
+        int listen_fd = -1;
+        int wake_pipe[2] = {-1, -1};
+        std::atomic<bool> stopping{false};
+        std::thread io_thread;
+        std::thread batch_thread;
+
+        std::mutex mutex;
+        std::condition_variable work_ready;
+        std::unordered_map<ContractKey, EntryPtr, ContractKeyHash> pending;
+        std::deque<EntryPtr> queue;
+
+        explicit Impl(ServiceConfig c) : config(std::move(c)) {}
+
+        void wake_io() {
+            char byte = 0;
+            (void)!::write(wake_pipe[1], &byte, 1);
+        }
+
+        // Never blocks: whatever the socket does not take now is left on the connection's
+        // outbox for the I/O thread to flush on POLLOUT, so a client that stops reading
+        // cannot stall the batch thread. A client whose outbox outgrows
+        // max_outbox_bytes is dropped.
+        void write_frame(const ConnectionPtr& conn, const std::vector<std::uint8_t>& frame) {
+            bool wake = false;
+            {
+                std::lock_guard<std::mutex> lock(conn->write_mutex);
+                if (conn->fd < 0 || conn->broken) {
+                    return;
+                }
+                bool idle = conn->unsent() == 0;
+                conn->outbox.insert(conn->outbox.end(), frame.begin(), frame.end());
+                if (!flush(*conn)) {
+                    conn->broken = true;
+                } else if (conn->unsent() > config.max_outbox_bytes) {
+                    conn->broken = true;
+                    metrics.dropped.fetch_add(1, std::memory_order_relaxed);
+                }
+                // The I/O thread only needs a nudge to start polling for POLLOUT or to close.
+                wake = conn->broken || (idle && conn->unsent() > 0);
+            }
+            if (wake) {
+                wake_io();
+            }
+        }
+
+        void send_reply(const JobPtr& job) {
+            Clock::time_point ready = Clock::now();
+            std::vector<std::uint8_t> frame;
+            std::size_t count = job->status.size();
+            std::size_t payload = sizeof(RequestPrefix) + count * (sizeof(WireStatus) + job->width * sizeof(double));
+            frame.reserve(sizeof(FrameHeader) + payload);
+
+            FrameHeader h;
+            h.type = static_cast<std::uint16_t>(job->type == MessageType::GreeksRequest ? MessageType::GreeksResponse
+                                                                                          : MessageType::ImpliedVolResponse);
+            h.request_id = job->request_id;
+            h.payload_bytes = static_cast<std::uint32_t>(payload);
+            RequestPrefix prefix;
+            prefix.columns = job->columns;
+            prefix.count = static_cast<std::uint32_t>(count);
+
+            auto append = [&frame](const void* p, std::size_t n) {
+                frame.insert(frame.end(), static_cast<const std::uint8_t*>(p), static_cast<const std::uint8_t*>(p) + n);
+            };
+            append(&h, sizeof(h));
+            append(&prefix, sizeof(prefix));
+            for (std::size_t i = 0; i < count; ++i) {
+                WireStatus s;
+                s.status = job->status[i];
+                append(&s, sizeof(s));
+                append(job->values.data() + i * job->width, job->width * sizeof(double));
+            }
+
+            write_frame(job->conn, frame);
+            Clock::time_point done = Clock::now();
+            metrics.reply.record(done - ready);
+            metrics.end_to_end.record(done - job->received);
+        }
+
+        void enqueue(const ConnectionPtr& conn, const FrameHeader& header, const std::uint8_t* payload) {
+            MessageType type = static_cast<MessageType>(header.type);
+            RequestPrefix prefix;
+            if (header.payload_bytes < sizeof(prefix)) {
+                reject(conn, header.request_id, "truncated request");
+                return;
+            }
+            std::memcpy(&prefix, payload, sizeof(prefix));
+            if (header.payload_bytes != sizeof(prefix) + std::size_t{prefix.count} * sizeof(WireContract) ||
+                (type == MessageType::GreeksRequest && (prefix.columns & ~kAllGreeks) != 0)) {
+                reject(conn, header.request_id, "malformed request");
+                return;
+            }
+
+            bool implied_vol = type == MessageType::ImpliedVolRequest;
+            std::size_t width = implied_vol ? 1 : column_count(prefix.columns);
+            // Replies are wider than requests, so a request that fits a frame may not fit one back.
+            if (sizeof(RequestPrefix) + std::size_t{prefix.count} * (sizeof(WireStatus) + width * sizeof(double)) >
+                kMaxPayloadBytes) {
+                reject(conn, header.request_id, "reply would exceed the frame size limit; split the request");
+                return;
+            }
+            auto job = std::make_shared<Job>();
+            job->conn = conn;
+            job->type = type;
+            job->request_id = header.request_id;
+            job->columns = implied_vol ? 0 : prefix.columns;
+            job->width = width;
+            job->received = Clock::now();
+            job->status.assign(prefix.count, 0);
+            job->values.assign(prefix.count * job->width, 0.0);
+            job->remaining = prefix.count;
+            metrics.requests.fetch_add(1, std::memory_order_relaxed);
+            metrics.contracts.fetch_add(prefix.count, std::memory_order_relaxed);
+
+            if (prefix.count == 0) {
+                send_reply(job);
+                return;
+            }
+
+            const std::uint8_t* rows = payload + sizeof(prefix);
+            std::uint64_t coalesced = 0;
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (std::uint32_t i = 0; i < prefix.count; ++i) {
+                    WireContract c;
+                    std::memcpy(&c, rows + i * sizeof(WireContract), sizeof(c));
+                    ContractKey key = make_key(c, implied_vol);
+
+                    auto it = pending.find(key);
+                    if (it != pending.end()) {
+                        Entry& e = *it->second;
+                        // A dispatched entry can still serve this row if it already covers the columns.
+                        // Its columns are then read by the batch thread, so only widen undispatched ones.
+                        if (!e.dispatched || (e.columns & job->columns) == job->columns) {
+                            if (!e.dispatched) {
+                                e.columns |= job->columns;
+                            }
+                            e.waiters.push_back({job, i});
+                            ++coalesced;
+                            continue;
+                        }
+                    }
+
+                    auto e = std::make_shared<Entry>();
+                    e->key = key;
+                    e->contract = c;
+                    e->implied_vol = implied_vol;
+                    e->columns = job->columns;
+                    e->enqueued = job->received;
+                    e->waiters.push_back({job, i});
+                    pending[key] = e;
+                    queue.push_back(std::move(e));
+                }
+            }
+            metrics.coalesced.fetch_add(coalesced, std::memory_order_relaxed);
+            work_ready.notify_one();
+        }
+
+        void reject(const ConnectionPtr& conn, std::uint32_t request_id, const std::string& reason) {
+            std::vector<std::uint8_t> frame;
+            encode_text(frame, MessageType::ErrorResponse, request_id, reason);
+            write_frame(conn, frame);
+        }
+
+        void compute(std::vector<EntryPtr>& batch) {
+            std::vector<Entry*> greeks, vols;
+            GreekMask columns = 0;
+            for (auto& e : batch) {
+                (e->implied_vol ? vols : greeks).push_back(e.get());
+                columns |= e->columns;
+            }
+
+            auto run = [&](const std::vector<Entry*>& rows, auto&& body) {
+                std::size_t n = rows.size();
+                if (n == 0) {
+                    return;
+                }
+                std::vector<std::uint8_t> call(n);
+                std::vector<double> S(n), K(n), T(n), r(n), sigma(n), q(n);
+                std::vector<std::int32_t> status(n);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const WireContract& c = rows[i]->contract;
+                    call[i] = c.call;
+                    S[i] = c.S; K[i] = c.K; T[i] = c.T; r[i] = c.r; sigma[i] = c.sigma; q[i] = c.q;
+                }
+                BatchInputs in;
+                in.count = n;
+                in.call = {call.data(), 1};
+                in.S = {S.data(), 1};
+                in.K = {K.data(), 1};
+                in.T = {T.data(), 1};
+                in.r = {r.data(), 1};
+                in.sigma = {sigma.data(), 1};
+                in.q = {q.data(), 1};
+                body(in, status);
+                for (std::size_t i = 0; i < n; ++i) {
+                    rows[i]->status = status[i];
+                }
+            };
+
+            run(greeks, [&](const BatchInputs& in, std::vector<std::int32_t>& status) {
+                std::vector<double> storage(in.count * kGreekColumnCount);
+                BatchOutputs out;
+                out.columns = columns;
+                out.status = {status.data(), 1};
+                for (int c = 0; c < kGreekColumnCount; ++c) {
+                    out.greeks[c] = {storage.data() + c, kGreekColumnCount};
+                }
+                batch_greeks(in, out, config.scaling, config.threads);
+                for (std::size_t i = 0; i < in.count; ++i) {
+                    std::copy_n(storage.data() + i * kGreekColumnCount, kGreekColumnCount, greeks[i]->values);
+                }
+            });
+
+            run(vols, [&](const BatchInputs& in, std::vector<std::int32_t>& status) {
+                std::vector<double> iv(in.count);
+                batch_implied_volatility(in, in.sigma, {iv.data(), 1}, {status.data(), 1}, config.threads);
+                for (std::size_t i = 0; i < in.count; ++i) {
+                    vols[i]->values[0] = iv[i];
+                }
+            });
+        }
+
+        void complete(std::vector<EntryPtr>& batch) {
+            std::vector<std::pair<EntryPtr, std::vector<Waiter>>> finished;
+            finished.reserve(batch.size());
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                for (auto& e : batch) {
+                    auto it = pending.find(e->key);
+                    if (it != pending.end() && it->second == e) {
+                        pending.erase(it);
+                    }
+                    finished.emplace_back(e, std::move(e->waiters));
+                }
+            }
+
+            for (auto& [entry, waiters] : finished) {
+                for (const Waiter& w : waiters) {
+                    Job& job = *w.job;
+                    job.status[w.row] = entry->status;
+                    double* row = job.values.data() + w.row * job.width;
+                    if (entry->implied_vol) {
+                        row[0] = entry->values[0];
+                    } else {
+                        std::size_t k = 0;
+                        for (int c = 0; c < kGreekColumnCount; ++c) {
+                            if (job.columns & greek_bit(static_cast<GreekColumn>(c))) {
+                                row[k++] = entry->values[c];
+                            }
+                        }
+                    }
+                    if (job.remaining.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                        send_reply(w.job);
+                    }
+                }
+            }
+        }
+
+        void batch_loop() {
+            while (true) {
+                std::vector<EntryPtr> batch;
+                {
+                    std::unique_lock<std::mutex> lock(mutex);
+                    work_ready.wait(lock, [&] { return stopping.load() || !queue.empty(); });
+                    if (stopping) {
+                        return;
+                    }
+                    // Hold the batch open until it is full or its oldest contract hits the delay budget.
+                    Clock::time_point deadline = queue.front()->enqueued + config.max_batch_delay;
+                    while (!stopping && queue.size() < config.max_batch_size && Clock::now() < deadline) {
+                        work_ready.wait_until(lock, deadline);
+                    }
+                    std::size_t n = std::min(queue.size(), std::max<std::size_t>(config.max_batch_size, 1));
+                    batch.assign(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(n));
+                    queue.erase(queue.begin(), queue.begin() + static_cast<std::ptrdiff_t>(n));
+                    for (auto& e : batch) {
+                        e->dispatched = true;
+                    }
+                }
+
+                Clock::time_point start = Clock::now();
+                for (auto& e : batch) {
+                    metrics.queue.record(start - e->enqueued);
+                }
+                compute(batch);
+                metrics.compute.record(Clock::now() - start);
+                metrics.batches.fetch_add(1, std::memory_order_relaxed);
+                metrics.batched_rows.fetch_add(batch.size(), std::memory_order_relaxed);
+                complete(batch);
+            }
+        }
+
+        // Parses every complete frame in the connection's inbox.
+        bool drain_frames(const ConnectionPtr& conn) {
+            std::vector<std::uint8_t>& in = conn->inbox;
+            std::size_t offset = 0;
+            while (in.size() - offset >= sizeof(FrameHeader)) {
+                FrameHeader h;
+                std::memcpy(&h, in.data() + offset, sizeof(h));
+                if (!header_valid(h)) {
+                    reject(conn, h.request_id, "bad frame header");
+                    return false;
+                }
+                if (in.size() - offset < sizeof(h) + h.payload_bytes) {
+                    break;
+                }
+                const std::uint8_t* payload = in.data() + offset + sizeof(h);
+                switch (static_cast<MessageType>(h.type)) {
+                    case MessageType::GreeksRequest:
+                    case MessageType::ImpliedVolRequest:
+                        enqueue(conn, h, payload);
+                        break;
+                    case MessageType::StatsRequest: {
+                        std::vector<std::uint8_t> frame;
+                        encode_text(frame, MessageType::StatsResponse, h.request_id, metrics.report());
+                        write_frame(conn, frame);
+                        break;
+                    }
+                    default:
+                        reject(conn, h.request_id, "unknown message type");
+                        break;
+                }
+                offset += sizeof(h) + h.payload_bytes;
+            }
+            in.erase(in.begin(), in.begin() + static_cast<std::ptrdiff_t>(offset));
+            return true;
+        }
+
+        void close_connection(const ConnectionPtr& conn) {
+            std::lock_guard<std::mutex> lock(conn->write_mutex);
+            if (conn->fd >= 0) {
+                ::close(conn->fd);
+                conn->fd = -1;
+            }
+            conn->outbox.clear();
+            conn->sent = 0;
+        }
+
+        void io_loop() {
+            std::vector<ConnectionPtr> connections;
+            std::vector<pollfd> fds;
+            std::uint8_t buffer[1 << 16];
+
+            while (!stopping) {
+                fds.clear();
+                fds.push_back({wake_pipe[0], POLLIN, 0});
+                fds.push_back({listen_fd, POLLIN, 0});
+                for (auto& c : connections) {
+                    std::lock_guard<std::mutex> lock(c->write_mutex);
+                    short events = c->broken ? 0 : POLLIN;
+                    if (c->unsent() > 0) {
+                        events |= POLLOUT;
+                    }
+                    fds.push_back({c->fd, events, 0});
+                }
+                if (::poll(fds.data(), fds.size(), -1) < 0) {
+                    continue;
+                }
+                if (fds[0].revents) {
+                    while (::read(wake_pipe[0], buffer, sizeof(buffer)) > 0) {
+                    }
+                    if (stopping) {
+                        break;
+                    }
+                }
+
+                if (fds[1].revents & POLLIN) {
+                    int fd;
+                    while ((fd = ::accept(listen_fd, nullptr, nullptr)) >= 0) {
+                        set_nonblocking(fd);
+                        auto conn = std::make_shared<Connection>();
+                        conn->fd = fd;
+                        connections.push_back(std::move(conn));
+                    }
+                }
+
+                std::vector<ConnectionPtr> alive;
+                alive.reserve(connections.size());
+                for (std::size_t i = 0; i < connections.size(); ++i) {
+                    const ConnectionPtr& conn = connections[i];
+                    bool open = true;
+                    if (fds[i + 2].revents & POLLOUT) {
+                        std::lock_guard<std::mutex> lock(conn->write_mutex);
+                        if (!flush(*conn)) {
+                            conn->broken = true;
+                        }
+                    }
+                    {
+                        std::lock_guard<std::mutex> lock(conn->write_mutex);
+                        open = !conn->broken;
+                    }
+                    if (open && (fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR))) {
+                        while (true) {
+                            ssize_t n = ::recv(conn->fd, buffer, sizeof(buffer), 0);
+                            if (n > 0) {
+                                conn->inbox.insert(conn->inbox.end(), buffer, buffer + n);
+                            } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                                break;
+                            } else if (n < 0 && errno == EINTR) {
+                                continue;
+                            } else {
+                                open = false;
+                                break;
+                            }
+                        }
+                        open = drain_frames(conn) && open;
+                    }
+                    if (open) {
+                        alive.push_back(conn);
+                    } else {
+                        close_connection(conn);
+                    }
+                }
+                connections.swap(alive);
+            }
+
+            for (auto& c : connections) {
+                close_connection(c);
+            }
+        }
+    };
+
+    PricingServer::PricingServer(ServiceConfig config) : impl_(std::make_unique<Impl>(std::move(config))) {}
+
+    PricingServer::~PricingServer() {
+        stop();
+    }
+
+    const ServiceMetrics& PricingServer::metrics() const {
+        return impl_->metrics;
+    }
+
+    void PricingServer::start() {
+        Impl& s = *impl_;
+        sockaddr_un addr{};
+        addr.sun_family = AF_UNIX;
+        if (s.config.socket_path.size() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error("Socket path too long: " + s.config.socket_path);
+        }
+        std::strncpy(addr.sun_path, s.config.socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        if (::pipe(s.wake_pipe) < 0) {
+            throw std::runtime_error("pipe() failed: " + std::string(std::strerror(errno)));
+        }
+        set_nonblocking(s.wake_pipe[0]);
+        set_nonblocking(s.wake_pipe[1]);
+        // stop() only cleans up a started server, so undo everything here on failure.
+        auto fail = [&s](const std::string& message) {
+            std::string err = std::strerror(errno);
+            if (s.listen_fd >= 0) {
+                ::close(s.listen_fd);
+                s.listen_fd = -1;
+            }
+            ::close(s.wake_pipe[0]);
+            ::close(s.wake_pipe[1]);
+            s.wake_pipe[0] = s.wake_pipe[1] = -1;
+            throw std::runtime_error(message + ": " + err);
+        };
+        s.listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (s.listen_fd < 0) {
+            fail("socket() failed");
+        }
+        ::unlink(s.config.socket_path.c_str());
+        if (::bind(s.listen_fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(s.listen_fd, 128) < 0) {
+            fail("Cannot listen on " + s.config.socket_path);
+        }
+        set_nonblocking(s.listen_fd);
+
+        s.stopping = false;
+        s.batch_thread = std::thread([&s] { s.batch_loop(); });
+        s.io_thread = std::thread([&s] { s.io_loop(); });
+    }
+
+    void PricingServer::stop() {
+        Impl& s = *impl_;
+        if (s.listen_fd < 0) {
+            return;
+        }
+        s.stopping = true;
+        s.wake_io();
+        {
+            std::lock_guard<std::mutex> lock(s.mutex);
+        }
+        s.work_ready.notify_all();
+        if (s.io_thread.joinable()) {
+            s.io_thread.join();
+        }
+        if (s.batch_thread.joinable()) {
+            s.batch_thread.join();
+        }
+
+        ::close(s.listen_fd);
+        ::close(s.wake_pipe[0]);
+        ::close(s.wake_pipe[1]);
+        s.listen_fd = -1;
+        s.wake_pipe[0] = s.wake_pipe[1] = -1;
+        ::unlink(s.config.socket_path.c_str());
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include "Greeks.h"
+#include "service/metrics.h"
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace GreeksCalculator {
+    struct ServiceConfig {
+        std::string socket_path = "/tmp/openquantgreeks.sock";
+        // Longest a contract waits for more work to join its batch. Larger values
+        // give bigger batches and more coalescing at the cost of latency.
+        std::chrono::microseconds max_batch_delay{200};
+        std::size_t max_batch_size = 4096;
+        int threads = 0;                                  // Batch engine workers; 0 = all cores
+        // Unsent reply bytes a client may accumulate before it is disconnected.
+        std::size_t max_outbox_bytes = std::size_t{64} << 20;
+        ScalingParams scaling = ScalingParams::standard();
+    };
+
+    // Local pricing daemon on a Unix-domain socket. Identical contracts that are
+    // requested while an earlier request for them is still pending are computed
+    // once, and pending contracts are grouped into micro-batches for batch_greeks /
+    // batch_implied_volatility. Replies are sent as soon as every row of a request
+    // is done, so they can arrive in a different order than the requests. Replies
+    // are queued per connection and flushed by the I/O thread, so a client that
+    // stops reading never delays the others.
+    class PricingServer {
+    public:
+        explicit PricingServer(ServiceConfig config);
+        ~PricingServer();
+
+        PricingServer(const PricingServer&) = delete;
+        PricingServer& operator=(const PricingServer&) = delete;
+
+        void start();   // Binds the socket and starts the I/O and batching threads; throws std::runtime_error
+        void stop();    // Idempotent; also called by the destructor
+
+        const ServiceMetrics& metrics() const;
+
+    private:
+        struct Impl;
+        std::unique_ptr<Impl> impl_;
+    };
+}
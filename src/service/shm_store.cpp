@@ -0,0 +1,377 @@
+#include "service/shm_store.h"
+#include "publish/seqlock.h"
+#include <atomic>
+#include <bitset>
+#include <chrono>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace GreeksCalculator {
+    namespace {
+        constexpr char kMagic[8] = {'O', 'Q', 'G', 'S', 'H', 'M', 'G', 'K'};
+        constexpr std::size_t kLine = 64;
+
+        enum : std::uint32_t { kInitializing = 0, kLive = 1, kClosed = 2 };
+
+        // Written once by the producer before `state` becomes kLive; the second line
+        // changes while the segment is live.
+        struct Header {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t width;
+            std::uint64_t columns;
+            std::uint64_t capacity;
+            std::uint64_t buckets;              // Power of two
+            std::uint64_t index_offset;
+            std::uint64_t slots_offset;
+            std::uint64_t slot_words;
+            std::uint64_t total_bytes;
+            std::uint64_t owner;                // Identifies the producer that created it
+            alignas(kLine) std::atomic<std::uint32_t> state;
+            std::atomic<std::uint64_t> count;
+            std::atomic<std::int64_t> heartbeat_ns;
+        };
+
+        // slot_plus_one is written after key with release, so a reader that sees it
+        // non-zero also sees the key.
+        struct IndexEntry {
+            std::atomic<std::uint64_t> key;
+            std::atomic<std::uint64_t> slot_plus_one;
+        };
+
+        static_assert(sizeof(Header) % kLine == 0, "Header layout");
+        static_assert(sizeof(IndexEntry) == 16, "IndexEntry layout");
+        static_assert(std::atomic<std::uint32_t>::is_always_lock_free && std::atomic<std::int64_t>::is_always_lock_free,
+                      "shared-memory atomics must be lock-free");
+
+        std::size_t round_up(std::size_t n, std::size_t to) {
+            return (n + to - 1) / to * to;
+        }
+
+        std::uint64_t mix(std::uint64_t x) {
+            x ^= x >> 33;
+            x *= 0xff51afd7ed558ccdull;
+            x ^= x >> 33;
+            x *= 0xc4ceb9fe1a85ec53ull;
+            return x ^ (x >> 33);
+        }
+
+        std::string shm_name(const std::string& name) {
+            return !name.empty() && name[0] == '/' ? name : "/" + name;
+        }
+    }
+
+    namespace detail {
+        struct ShmSegment {
+            void* base = nullptr;
+            std::size_t bytes = 0;
+            Header* header = nullptr;
+            IndexEntry* index = nullptr;
+            std::atomic<std::uint64_t>* slots = nullptr;
+
+            ~ShmSegment() {
+                if (base) {
+                    ::munmap(base, bytes);
+                }
+            }
+
+            void attach(void* map, std::size_t size) {
+                base = map;
+                bytes = size;
+                header = static_cast<Header*>(map);
+                index = reinterpret_cast<IndexEntry*>(static_cast<char*>(map) + header->index_offset);
+                slots = reinterpret_cast<std::atomic<std::uint64_t>*>(static_cast<char*>(map) + header->slots_offset);
+            }
+
+            std::atomic<std::uint64_t>* words(std::size_t slot) const {
+                return slots + slot * header->slot_words;
+            }
+
+            long find(std::uint64_t contract) const {
+                std::uint64_t mask = header->buckets - 1;
+                for (std::uint64_t b = mix(contract) & mask;; b = (b + 1) & mask) {
+                    std::uint64_t slot = index[b].slot_plus_one.load(std::memory_order_acquire);
+                    if (slot == 0) {
+                        return -1;
+                    }
+                    if (index[b].key.load(std::memory_order_relaxed) == contract) {
+                        return static_cast<long>(slot - 1);
+                    }
+                }
+            }
+
+            bool read(std::size_t slot, double* values, std::int64_t* updated_ns) const {
+                if (slot >= header->capacity) {
+                    return false;
+                }
+                std::uint64_t stamp;
+                if (!seqlock::read(words(slot), stamp, values, header->width)) {
+                    return false;
+                }
+                if (updated_ns) {
+                    *updated_ns = static_cast<std::int64_t>(stamp);
+                }
+                return true;
+            }
+        };
+    }
+
+    std::int64_t shm_clock_ns() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    ShmGreekProducer::ShmGreekProducer(const std::string& name, std::size_t capacity, GreekMask columns)
+        : segment_(nullptr), name_(shm_name(name)) {
+        columns &= kAllGreeks;
+        std::size_t width = std::bitset<64>(columns).count();
+        if (capacity == 0 || width == 0 || capacity > (std::numeric_limits<std::uint32_t>::max)()) {
+            throw std::invalid_argument("Invalid shared-memory Greek store size or columns.");
+        }
+
+        // Close an existing store of the same name so its consumers stop trusting it.
+        int old = ::shm_open(name_.c_str(), O_RDWR, 0);
+        if (old >= 0) {
+            struct stat st;
+            if (::fstat(old, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(Header)) {
+                void* map = ::mmap(nullptr, sizeof(Header), PROT_READ | PROT_WRITE, MAP_SHARED, old, 0);
+                if (map != MAP_FAILED) {
+                    Header* h = static_cast<Header*>(map);
+                    if (std::memcmp(h->magic, kMagic, sizeof(kMagic)) == 0) {
+                        h->state.store(kClosed, std::memory_order_release);
+                    }
+                    ::munmap(map, sizeof(Header));
+                }
+            }
+            ::close(old);
+            ::shm_unlink(name_.c_str());
+        }
+
+        std::size_t buckets = 16;
+        while (buckets < 2 * capacity) {
+            buckets *= 2;
+        }
+        std::size_t slot_words = round_up(seqlock::kHeaderWords + width, kLine / sizeof(std::uint64_t));
+        std::size_t index_offset = sizeof(Header);
+        std::size_t slots_offset = round_up(index_offset + buckets * sizeof(IndexEntry), kLine);
+        std::size_t total = slots_offset + capacity * slot_words * sizeof(std::uint64_t);
+
+        int fd = ::shm_open(name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot create shared-memory Greek store: " + name_);
+        }
+        if (::ftruncate(fd, static_cast<off_t>(total)) != 0) {
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            throw std::runtime_error("Cannot size shared-memory Greek store: " + name_);
+        }
+        void* map = ::mmap(nullptr, total, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            ::shm_unlink(name_.c_str());
+            throw std::runtime_error("Cannot map shared-memory Greek store: " + name_);
+        }
+
+        // ftruncate zero-fills, which is every atomic's initial value.
+        Header* h = new (map) Header;
+        std::memcpy(h->magic, kMagic, sizeof(kMagic));
+        h->version = kShmStoreVersion;
+        h->width = static_cast<std::uint32_t>(width);
+        h->columns = columns;
+        h->capacity = capacity;
+        h->buckets = buckets;
+        h->index_offset = index_offset;
+        h->slots_offset = slots_offset;
+        h->slot_words = slot_words;
+        h->total_bytes = total;
+        h->owner = mix(static_cast<std::uint64_t>(shm_clock_ns()) ^ (static_cast<std::uint64_t>(::getpid()) << 32) ^
+                       reinterpret_cast<std::uintptr_t>(map));
+        segment_ = new detail::ShmSegment;
+        segment_->attach(map, total);
+        h->state.store(kLive, std::memory_order_release);
+    }
+
+    ShmGreekProducer::~ShmGreekProducer() {
+        segment_->header->state.store(kClosed, std::memory_order_release);
+        // Leave the name alone if a newer producer has already replaced the segment.
+        bool ours = false;
+        int fd = ::shm_open(name_.c_str(), O_RDONLY, 0);
+        if (fd >= 0) {
+            struct stat st;
+            if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(Header)) {
+                void* map = ::mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+                if (map != MAP_FAILED) {
+                    ours = static_cast<const Header*>(map)->owner == segment_->header->owner;
+                    ::munmap(map, sizeof(Header));
+                }
+            }
+            ::close(fd);
+        }
+        if (ours) {
+            ::shm_unlink(name_.c_str());
+        }
+        delete segment_;
+    }
+
+    std::size_t ShmGreekProducer::add(std::uint64_t contract) {
+        long existing = segment_->find(contract);
+        if (existing >= 0) {
+            return static_cast<std::size_t>(existing);
+        }
+        Header* h = segment_->header;
+        std::uint64_t slot = h->count.load(std::memory_order_relaxed);
+        if (slot >= h->capacity) {
+            throw std::length_error("Shared-memory Greek store is full.");
+        }
+        std::uint64_t mask = h->buckets - 1;
+        std::uint64_t b = mix(contract) & mask;
+        while (segment_->index[b].slot_plus_one.load(std::memory_order_relaxed) != 0) {
+            b = (b + 1) & mask;
+        }
+        segment_->index[b].key.store(contract, std::memory_order_relaxed);
+        segment_->index[b].slot_plus_one.store(slot + 1, std::memory_order_release);
+        h->count.store(slot + 1, std::memory_order_release);
+        return static_cast<std::size_t>(slot);
+    }
+
+    long ShmGreekProducer::find(std::uint64_t contract) const {
+        return segment_->find(contract);
+    }
+
+    void ShmGreekProducer::publish(std::size_t slot, const Greeks& g) {
+        double values[kGreekColumnCount];
+        pack_greeks(segment_->header->columns, g, values);
+        publish(slot, values);
+    }
+
+    void ShmGreekProducer::publish(std::size_t slot, const double* values) {
+        if (slot >= segment_->header->count.load(std::memory_order_relaxed)) {
+            throw std::out_of_range("Shared-memory Greek store slot was never added.");
+        }
+        seqlock::write(segment_->words(slot), static_cast<std::uint64_t>(shm_clock_ns()), values, segment_->header->width);
+    }
+
+    std::size_t ShmGreekProducer::publish_batch(const BatchInputs& in, StridedView<const std::uint32_t> slots,
+                                                const ScalingParams& scaling, int threads) {
+        const GreekMask columns = segment_->header->columns;
+        const std::uint64_t count = segment_->header->count.load(std::memory_order_relaxed);
+        BsmKernel kernel{scaling};
+        return detail::for_each_row(in.count, threads, [&](std::size_t i) {
+            bool call = in.call ? in.call[i] != 0 : true;
+            double S = in.S[i], K = in.K[i], T = in.T[i], r = in.r[i], sigma = in.sigma[i];
+            double q = in.q ? in.q[i] : 0.0;
+            if (slots[i] >= count || !kernel.valid(S, K, T, r, sigma, q)) {
+                return BatchStatus::InvalidInput;
+            }
+            Greeks g;
+            kernel(columns, call, S, K, T, r, sigma, q, g);
+            publish(slots[i], g);
+            return BatchStatus::Ok;
+        }, [](std::size_t) {});
+    }
+
+    void ShmGreekProducer::heartbeat() {
+        segment_->header->heartbeat_ns.store(shm_clock_ns(), std::memory_order_release);
+    }
+
+    std::size_t ShmGreekProducer::capacity() const {
+        return segment_->header->capacity;
+    }
+
+    std::size_t ShmGreekProducer::size() const {
+        return segment_->header->count.load(std::memory_order_acquire);
+    }
+
+    GreekMask ShmGreekProducer::columns() const {
+        return segment_->header->columns;
+    }
+
+    std::size_t ShmGreekProducer::width() const {
+        return segment_->header->width;
+    }
+
+    ShmGreekReader::ShmGreekReader(const std::string& name) : segment_(nullptr) {
+        std::string path = shm_name(name);
+        int fd = ::shm_open(path.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw std::runtime_error("No shared-memory Greek store named " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(Header)) {
+            ::close(fd);
+            throw std::runtime_error("Shared-memory Greek store is not initialized: " + path);
+        }
+        std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        void* map = ::mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            throw std::runtime_error("Cannot map shared-memory Greek store: " + path);
+        }
+
+        const Header* h = static_cast<const Header*>(map);
+        bool ok = h->state.load(std::memory_order_acquire) != kInitializing &&
+                  std::memcmp(h->magic, kMagic, sizeof(kMagic)) == 0 && h->version == kShmStoreVersion &&
+                  h->total_bytes == bytes && h->width == std::bitset<64>(h->columns).count() &&
+                  h->slots_offset + h->capacity * h->slot_words * sizeof(std::uint64_t) <= bytes;
+        if (!ok) {
+            ::munmap(map, bytes);
+            throw std::runtime_error("Not a shared-memory Greek store (or unsupported version): " + path);
+        }
+        segment_ = new detail::ShmSegment;
+        segment_->attach(map, bytes);
+    }
+
+    ShmGreekReader::~ShmGreekReader() {
+        delete segment_;
+    }
+
+    long ShmGreekReader::find(std::uint64_t contract) const {
+        return segment_->find(contract);
+    }
+
+    bool ShmGreekReader::read(std::size_t slot, Greeks& out, std::int64_t* updated_ns) const {
+        double values[kGreekColumnCount];
+        if (!segment_->read(slot, values, updated_ns)) {
+            return false;
+        }
+        unpack_greeks(segment_->header->columns, values, out);
+        return true;
+    }
+
+    bool ShmGreekReader::read(std::size_t slot, double* values, std::int64_t* updated_ns) const {
+        return segment_->read(slot, values, updated_ns);
+    }
+
+    std::uint64_t ShmGreekReader::version(std::size_t slot) const {
+        return slot < segment_->header->capacity ? seqlock::version(segment_->words(slot)) : 0;
+    }
+
+    std::size_t ShmGreekReader::capacity() const {
+        return segment_->header->capacity;
+    }
+
+    std::size_t ShmGreekReader::size() const {
+        return segment_->header->count.load(std::memory_order_acquire);
+    }
+
+    GreekMask ShmGreekReader::columns() const {
+        return segment_->header->columns;
+    }
+
+    std::size_t ShmGreekReader::width() const {
+        return segment_->header->width;
+    }
+
+    std::int64_t ShmGreekReader::heartbeat_ns() const {
+        return segment_->header->heartbeat_ns.load(std::memory_order_acquire);
+    }
+
+    bool ShmGreekReader::closed() const {
+        return segment_->header->state.load(std::memory_order_acquire) == kClosed;
+    }
+}
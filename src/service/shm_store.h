@@ -0,0 +1,93 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/batch.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace GreeksCalculator {
+    // Cross-process Greek store in POSIX shared memory. One producer process creates the
+    // segment and publishes; any number of consumer processes map it read-only and read
+    // in place, without syscalls or locks. The segment is
+    //   header | contract index (open addressing, contract id -> slot) | slots
+    // where every slot is a cache-line-aligned seqlock record (publish/seqlock.h) stamped
+    // with the publication time in nanoseconds since the Unix epoch.
+    constexpr std::uint32_t kShmStoreVersion = 1;
+
+    // Nanoseconds since the Unix epoch, the clock of every stamp in the store.
+    std::int64_t shm_clock_ns();
+
+    namespace detail {
+        struct ShmSegment;
+    }
+
+    class ShmGreekProducer {
+    public:
+        // Creates (or replaces) the segment `name` ("/oqg_greeks"; a leading '/' is added
+        // if missing) with room for `capacity` contracts. Consumers of a replaced segment
+        // keep their mapping and see it as closed. Throws std::runtime_error.
+        ShmGreekProducer(const std::string& name, std::size_t capacity, GreekMask columns = kAllGreeks);
+        // Marks the segment closed and unlinks its name.
+        ~ShmGreekProducer();
+
+        ShmGreekProducer(const ShmGreekProducer&) = delete;
+        ShmGreekProducer& operator=(const ShmGreekProducer&) = delete;
+
+        // Registers a contract (or returns its existing slot). Only the producer's owning
+        // thread may add. Throws std::length_error when the store is full.
+        std::size_t add(std::uint64_t contract);
+        long find(std::uint64_t contract) const;                // -1 if unknown
+
+        // Publishes the configured columns of `g` (or width() packed values), stamped now.
+        // One thread per slot at a time; different slots may be published concurrently.
+        void publish(std::size_t slot, const Greeks& g);
+        void publish(std::size_t slot, const double* values);
+
+        // Evaluates `in` with the batch engine and publishes row i to slots[i]. A slot may
+        // appear at most once per call. Rows with invalid inputs keep their previous
+        // value. Returns the number of rows not published.
+        std::size_t publish_batch(const BatchInputs& in, StridedView<const std::uint32_t> slots,
+                                  const ScalingParams& scaling = ScalingParams::standard(), int threads = 0);
+
+        // Stamps the header, so consumers can tell a quiet producer from a dead one.
+        void heartbeat();
+
+        std::size_t capacity() const;
+        std::size_t size() const;
+        GreekMask columns() const;
+        std::size_t width() const;
+
+    private:
+        detail::ShmSegment* segment_;
+        std::string name_;
+    };
+
+    class ShmGreekReader {
+    public:
+        // Maps the segment read-only. Throws std::runtime_error if it does not exist, is
+        // not a Greek store of this version, or is still being initialized.
+        explicit ShmGreekReader(const std::string& name);
+        ~ShmGreekReader();
+
+        ShmGreekReader(const ShmGreekReader&) = delete;
+        ShmGreekReader& operator=(const ShmGreekReader&) = delete;
+
+        long find(std::uint64_t contract) const;                // -1 if unknown
+
+        // Latest publication of the slot and its stamp (shm_clock_ns). Only the store's
+        // columns of `out` are written. False if the slot has not been published yet.
+        bool read(std::size_t slot, Greeks& out, std::int64_t* updated_ns = nullptr) const;
+        bool read(std::size_t slot, double* values, std::int64_t* updated_ns = nullptr) const;
+        std::uint64_t version(std::size_t slot) const;          // Publications to the slot
+
+        std::size_t capacity() const;
+        std::size_t size() const;
+        GreekMask columns() const;
+        std::size_t width() const;
+        std::int64_t heartbeat_ns() const;                      // 0 if the producer never called heartbeat()
+        bool closed() const;                                    // The producer has gone or replaced the segment
+
+    private:
+        detail::ShmSegment* segment_;
+    };
+}
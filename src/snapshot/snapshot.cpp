@@ -0,0 +1,416 @@
+#include "snapshot/snapshot.h"
+#include "bsm/impliedvol.h"
+#include "bsm/validation.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define OQG_SNAPSHOT_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace GreeksCalculator {
+    namespace {
+        constexpr char kMagic[8] = {'O', 'Q', 'G', 'S', 'N', 'A', 'P', '1'};
+        constexpr std::uint32_t kFormatVersion = 1;
+
+        struct FileHeader {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t record_size;
+            std::uint64_t count;
+            double created;
+            ScalingParams scaling;
+            std::uint64_t checksum;             // Over the header (with this field zero) and the records
+            std::uint8_t reserved[40];
+        };
+
+        static_assert(sizeof(FileHeader) == 128, "FileHeader layout");
+        static_assert(sizeof(ContractState) % sizeof(std::uint64_t) == 0, "ContractState is hashed by word");
+
+        // FNV-1a over 64-bit words: snapshots can be large, and byte-wise hashing would
+        // dominate restore time.
+        std::uint64_t hash_words(const void* data, std::size_t bytes, std::uint64_t h = 1469598103934665603ull) {
+            const auto* p = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i + sizeof(std::uint64_t) <= bytes; i += sizeof(std::uint64_t)) {
+                std::uint64_t w;
+                std::memcpy(&w, p + i, sizeof(w));
+                h = (h ^ w) * 1099511628211ull;
+            }
+            return h;
+        }
+
+        std::uint64_t checksum(FileHeader header, const ContractState* records, std::size_t count) {
+            header.checksum = 0;
+            return hash_words(records, count * sizeof(ContractState), hash_words(&header, sizeof(header)));
+        }
+
+        bool same_scaling(const ScalingParams& a, const ScalingParams& b) {
+            return a.vega_scale == b.vega_scale && a.rho_scale == b.rho_scale && a.epsilon_scale == b.epsilon_scale &&
+                   a.theta_scale == b.theta_scale && a.charm_scale == b.charm_scale && a.color_scale == b.color_scale;
+        }
+
+        // Validates the header against the file size; returns the record count.
+        std::size_t check_header(const FileHeader& h, std::size_t file_bytes, const std::string& path) {
+            if (std::memcmp(h.magic, kMagic, sizeof(kMagic)) != 0 || h.version != kFormatVersion ||
+                h.record_size != sizeof(ContractState)) {
+                throw std::runtime_error("Not a contract state snapshot (or unsupported version): " + path);
+            }
+            if (h.count > (file_bytes - sizeof(FileHeader)) / sizeof(ContractState) ||
+                sizeof(FileHeader) + h.count * sizeof(ContractState) != file_bytes) {
+                throw std::runtime_error("Truncated contract state snapshot: " + path);
+            }
+            return static_cast<std::size_t>(h.count);
+        }
+
+        double wall_clock_seconds() {
+            return std::chrono::duration<double>(std::chrono::system_clock::now().time_since_epoch()).count();
+        }
+    }
+
+    BatchStatus evaluate_contract_state(ContractState& s, const ScalingParams& scaling) {
+        s.flags &= ~kStateRestored;
+        s.greeks = Greeks{};
+        s.sqrt_T = std::sqrt(s.T);
+        s.discount_r = std::exp(-s.r * s.T);
+        s.discount_q = std::exp(-s.q * s.T);
+
+        BatchStatus status = BatchStatus::Ok;
+        if (std::isfinite(s.market_price)) {
+            if (!inputs_valid(s.S, s.K, s.T, s.r, 0.1, s.q) || !(s.market_price > 0.0)) {
+                status = BatchStatus::InvalidInput;
+            } else {
+                s.sigma = calculate_implied_volatility(s.call(), s.S, s.K, s.T, s.r, s.market_price, s.q);
+                if (!std::isfinite(s.sigma)) {
+                    status = BatchStatus::NoConvergence;
+                }
+            }
+        }
+        if (status == BatchStatus::Ok && !inputs_valid(s.S, s.K, s.T, s.r, s.sigma, s.q)) {
+            status = BatchStatus::InvalidInput;
+        }
+        if (status == BatchStatus::Ok) {
+            try {
+                BsmKernel{scaling}(kAllGreeks, s.call(), s.S, s.K, s.T, s.r, s.sigma, s.q, s.greeks);
+            } catch (...) {
+                s.greeks = Greeks{};
+                status = BatchStatus::Error;
+            }
+        }
+        s.status = static_cast<std::int32_t>(status);
+        return status;
+    }
+
+    void write_snapshot(const std::string& path, const ContractState* records, std::size_t count,
+                        const ScalingParams& scaling, double created) {
+        FileHeader h{};
+        std::memcpy(h.magic, kMagic, sizeof(kMagic));
+        h.version = kFormatVersion;
+        h.record_size = sizeof(ContractState);
+        h.count = count;
+        h.created = created;
+        h.scaling = scaling;
+        h.checksum = checksum(h, records, count);
+
+        std::string temp = path + ".tmp";
+        {
+            std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+            if (!file) {
+                throw std::runtime_error("Cannot write contract state snapshot: " + temp);
+            }
+            file.write(reinterpret_cast<const char*>(&h), sizeof(h));
+            file.write(reinterpret_cast<const char*>(records), static_cast<std::streamsize>(count * sizeof(ContractState)));
+            file.close();
+            if (!file) {
+                std::remove(temp.c_str());
+                throw std::runtime_error("Failed writing contract state snapshot: " + temp);
+            }
+        }
+        if (std::rename(temp.c_str(), path.c_str()) != 0) {
+            std::remove(temp.c_str());
+            throw std::runtime_error("Cannot replace contract state snapshot: " + path);
+        }
+    }
+
+    SnapshotView SnapshotView::open(const std::string& path, bool verify) {
+        SnapshotView view;
+        FileHeader h;
+#ifdef OQG_SNAPSHOT_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Cannot open contract state snapshot: " + path);
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(FileHeader)) {
+            ::close(fd);
+            throw std::runtime_error("Truncated contract state snapshot: " + path);
+        }
+        std::size_t bytes = static_cast<std::size_t>(st.st_size);
+        void* map = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) {
+            throw std::runtime_error("Cannot map contract state snapshot: " + path);
+        }
+        view.mapping_ = map;
+        view.mapped_bytes_ = bytes;
+        std::memcpy(&h, map, sizeof(h));
+        view.count_ = check_header(h, bytes, path);
+        view.records_ = reinterpret_cast<const ContractState*>(static_cast<const char*>(map) + sizeof(FileHeader));
+#else
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file) {
+            throw std::runtime_error("Cannot open contract state snapshot: " + path);
+        }
+        std::size_t bytes = static_cast<std::size_t>(file.tellg());
+        file.seekg(0);
+        if (bytes < sizeof(FileHeader) || !file.read(reinterpret_cast<char*>(&h), sizeof(h))) {
+            throw std::runtime_error("Truncated contract state snapshot: " + path);
+        }
+        view.count_ = check_header(h, bytes, path);
+        view.buffer_.resize(view.count_);
+        if (!file.read(reinterpret_cast<char*>(view.buffer_.data()),
+                       static_cast<std::streamsize>(view.count_ * sizeof(ContractState)))) {
+            throw std::runtime_error("Truncated contract state snapshot: " + path);
+        }
+        view.records_ = view.buffer_.data();
+#endif
+        if (verify && checksum(h, view.records_, view.count_) != h.checksum) {
+            throw std::runtime_error("Contract state snapshot checksum mismatch: " + path);
+        }
+        view.scaling_ = h.scaling;
+        view.created_ = h.created;
+        return view;
+    }
+
+    SnapshotView::SnapshotView(SnapshotView&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    SnapshotView& SnapshotView::operator=(SnapshotView&& other) noexcept {
+        if (this != &other) {
+            release();
+            mapping_ = std::exchange(other.mapping_, nullptr);
+            mapped_bytes_ = std::exchange(other.mapped_bytes_, 0);
+            buffer_ = std::move(other.buffer_);
+            records_ = mapping_ ? std::exchange(other.records_, nullptr) : buffer_.data();
+            other.records_ = nullptr;
+            count_ = std::exchange(other.count_, 0);
+            scaling_ = other.scaling_;
+            created_ = other.created_;
+        }
+        return *this;
+    }
+
+    SnapshotView::~SnapshotView() {
+        release();
+    }
+
+    void SnapshotView::release() {
+#ifdef OQG_SNAPSHOT_MMAP
+        if (mapping_) {
+            ::munmap(mapping_, mapped_bytes_);
+        }
+#endif
+        mapping_ = nullptr;
+        mapped_bytes_ = 0;
+        buffer_.clear();
+        records_ = nullptr;
+        count_ = 0;
+    }
+
+    ContractStateStore::ContractStateStore(const ScalingParams& scaling) : scaling_(scaling) {}
+
+    ContractStateStore::~ContractStateStore() {
+        stop_snapshots();
+    }
+
+    const ContractState& ContractStateStore::at(std::uint32_t slot) const {
+        return (slot & kLive) ? live_[slot & ~kLive] : snapshot_.records()[slot];
+    }
+
+    std::size_t ContractStateStore::restore(const std::string& path, bool verify) {
+        SnapshotView view = SnapshotView::open(path, verify);
+        if (!same_scaling(view.scaling(), scaling_)) {
+            throw std::runtime_error("Contract state snapshot was written with different scaling: " + path);
+        }
+        if (view.size() >= kLive) {
+            throw std::runtime_error("Contract state snapshot too large: " + path);
+        }
+        std::unordered_map<std::uint64_t, std::uint32_t> index;
+        index.reserve(view.size());
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            index[view.records()[i].id] = static_cast<std::uint32_t>(i);    // A repeated id keeps its last record
+        }
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        index_ = std::move(index);
+        live_.clear();
+        snapshot_ = std::move(view);
+        restored_ = index_.size();
+        refresh_cursor_ = 0;
+        return restored_;
+    }
+
+    bool ContractStateStore::get(std::uint64_t id, ContractState& out) const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        auto it = index_.find(id);
+        if (it == index_.end()) {
+            return false;
+        }
+        out = at(it->second);
+        if (!(it->second & kLive)) {
+            out.flags |= kStateRestored;
+        }
+        return true;
+    }
+
+    void ContractStateStore::store(std::uint64_t id, const ContractState& state) {
+        auto it = index_.find(id);
+        if (it != index_.end() && (it->second & kLive)) {
+            live_[it->second & ~kLive] = state;
+            return;
+        }
+        if (it != index_.end()) {
+            --restored_;
+        }
+        index_[id] = static_cast<std::uint32_t>(live_.size()) | kLive;
+        live_.push_back(state);
+    }
+
+    BatchStatus ContractStateStore::update(std::uint64_t id, bool call, double S, double K, double T, double r,
+                                           double sigma, double q, double timestamp) {
+        ContractState s;
+        s.id = id;
+        s.flags = call ? kStateCall : 0;
+        s.S = S;
+        s.K = K;
+        s.T = T;
+        s.r = r;
+        s.q = q;
+        s.sigma = sigma;
+        s.updated = timestamp;
+        BatchStatus status = evaluate_contract_state(s, scaling_);
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        store(id, s);
+        return status;
+    }
+
+    BatchStatus ContractStateStore::update_price(std::uint64_t id, bool call, double S, double K, double T, double r,
+                                                 double market_price, double q, double timestamp) {
+        ContractState s;
+        s.id = id;
+        s.flags = call ? kStateCall : 0;
+        s.S = S;
+        s.K = K;
+        s.T = T;
+        s.r = r;
+        s.q = q;
+        s.market_price = std::isfinite(market_price) ? market_price : 0.0;
+        s.sigma = std::numeric_limits<double>::quiet_NaN();
+        s.updated = timestamp;
+        BatchStatus status = evaluate_contract_state(s, scaling_);
+
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        store(id, s);
+        return status;
+    }
+
+    std::size_t ContractStateStore::refresh_restored(std::size_t limit, double timestamp, double year, int threads) {
+        std::vector<ContractState> work;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            std::lock_guard<std::mutex> cursor(refresh_mutex_);
+            const ContractState* records = snapshot_.records();
+            for (; refresh_cursor_ < snapshot_.size() && work.size() < limit; ++refresh_cursor_) {
+                auto it = index_.find(records[refresh_cursor_].id);
+                if (it != index_.end() && it->second == refresh_cursor_) {
+                    work.push_back(records[refresh_cursor_]);
+                }
+            }
+        }
+
+        detail::for_each_row(work.size(), threads, [&](std::size_t i) {
+            ContractState& s = work[i];
+            s.T -= (timestamp - s.updated) / year;
+            s.updated = timestamp;
+            return evaluate_contract_state(s, scaling_);
+        }, [&](std::size_t i) {
+            work[i].greeks = Greeks{};
+            work[i].status = static_cast<std::int32_t>(BatchStatus::Error);
+        });
+
+        std::size_t refreshed = 0;
+        std::unique_lock<std::shared_mutex> lock(mutex_);
+        for (const ContractState& s : work) {
+            auto it = index_.find(s.id);
+            if (it != index_.end() && !(it->second & kLive)) {      // Not updated while we worked
+                store(s.id, s);
+                ++refreshed;
+            }
+        }
+        return refreshed;
+    }
+
+    std::size_t ContractStateStore::size() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return index_.size();
+    }
+
+    std::size_t ContractStateStore::restored() const {
+        std::shared_lock<std::shared_mutex> lock(mutex_);
+        return restored_;
+    }
+
+    void ContractStateStore::save(const std::string& path) const {
+        std::vector<ContractState> records;
+        {
+            std::shared_lock<std::shared_mutex> lock(mutex_);
+            records.reserve(index_.size());
+            for (const auto& entry : index_) {
+                records.push_back(at(entry.second));
+                if (!(entry.second & kLive)) {
+                    records.back().flags |= kStateRestored;
+                }
+            }
+        }
+        write_snapshot(path, records.data(), records.size(), scaling_, wall_clock_seconds());
+    }
+
+    void ContractStateStore::start_snapshots(const std::string& path, std::chrono::milliseconds interval) {
+        stop_snapshots();
+        writer_stop_ = false;
+        writer_ = std::thread([this, path, interval] {
+            std::unique_lock<std::mutex> lock(writer_mutex_);
+            while (!writer_wake_.wait_for(lock, interval, [this] { return writer_stop_; })) {
+                lock.unlock();
+                try {
+                    save(path);
+                    snapshots_written_.fetch_add(1);
+                } catch (...) {
+                    snapshot_failures_.fetch_add(1);
+                }
+                lock.lock();
+            }
+        });
+    }
+
+    void ContractStateStore::stop_snapshots() {
+        if (!writer_.joinable()) {
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(writer_mutex_);
+            writer_stop_ = true;
+        }
+        writer_wake_.notify_all();
+        writer_.join();
+    }
+}
@@ -0,0 +1,164 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/batch.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace GreeksCalculator {
+    // ContractState::flags
+    constexpr std::uint32_t kStateCall = 1u << 0;
+    constexpr std::uint32_t kStateRestored = 1u << 1;   // Served from a snapshot, not recomputed since
+
+    // Everything the engine keeps per contract, in a fixed layout that is written to
+    // snapshots as is. `sigma` is the last implied (or supplied) volatility, and the
+    // T-dependent factors are cached so a restored record can be served without work.
+    struct ContractState {
+        std::uint64_t id = 0;
+        std::uint32_t flags = 0;
+        std::int32_t status = 0;            // BatchStatus of the last evaluation
+        double S = 0.0;
+        double K = 0.0;
+        double T = 0.0;
+        double r = 0.0;
+        double q = 0.0;
+        double sigma = 0.0;
+        double market_price = std::numeric_limits<double>::quiet_NaN();   // NaN when sigma was supplied
+        double discount_r = 0.0;            // exp(-rT)
+        double discount_q = 0.0;            // exp(-qT)
+        double sqrt_T = 0.0;
+        double updated = 0.0;               // Caller's timestamp of the last evaluation
+        Greeks greeks;
+
+        bool call() const { return (flags & kStateCall) != 0; }
+        bool restored() const { return (flags & kStateRestored) != 0; }
+    };
+
+    static_assert(std::is_trivially_copyable<ContractState>::value, "ContractState is written to disk as is");
+    static_assert(sizeof(Greeks) == kGreekColumnCount * sizeof(double), "Greeks layout");
+
+    // Recomputes the cached factors, sigma (from market_price when it is finite) and every
+    // Greek of `state` from its inputs. Invalid inputs or a failed solve leave NaN Greeks
+    // and the matching status. Clears kStateRestored.
+    BatchStatus evaluate_contract_state(ContractState& state, const ScalingParams& scaling);
+
+    // Snapshot file: a 128-byte header (magic, format version, record size, record count,
+    // creation time, the ScalingParams of the stored Greeks, checksum) followed by the
+    // records. Native byte order; snapshots are for restarting on the same host. The file
+    // is written to `path`.tmp and renamed over `path`, so readers never see a partial one.
+    void write_snapshot(const std::string& path, const ContractState* records, std::size_t count,
+                        const ScalingParams& scaling, double created);
+
+    // Read-only view of a snapshot file. On POSIX the records are memory-mapped, so pages
+    // are only read when touched; elsewhere the file is read into memory. Throws
+    // std::runtime_error on a missing, truncated, foreign or corrupt file. `verify` checks
+    // the checksum, which reads every page once.
+    class SnapshotView {
+    public:
+        static SnapshotView open(const std::string& path, bool verify = true);
+
+        SnapshotView() = default;
+        SnapshotView(SnapshotView&& other) noexcept;
+        SnapshotView& operator=(SnapshotView&& other) noexcept;
+        SnapshotView(const SnapshotView&) = delete;
+        SnapshotView& operator=(const SnapshotView&) = delete;
+        ~SnapshotView();
+
+        const ContractState* records() const { return records_; }
+        std::size_t size() const { return count_; }
+        const ScalingParams& scaling() const { return scaling_; }
+        double created() const { return created_; }
+
+    private:
+        void release();
+
+        void* mapping_ = nullptr;
+        std::size_t mapped_bytes_ = 0;
+        std::vector<ContractState> buffer_;     // Used when the file is not mapped
+        const ContractState* records_ = nullptr;
+        std::size_t count_ = 0;
+        ScalingParams scaling_;
+        double created_ = 0.0;
+    };
+
+    // Per-contract state of a pricing process, keyed by a caller-chosen contract id.
+    // restore() serves a snapshot's records straight from the mapping; a record is
+    // copied into the store the first time it is updated or refreshed, so a restart can
+    // answer get() as soon as the index is built. Safe for concurrent readers and writers.
+    class ContractStateStore {
+    public:
+        explicit ContractStateStore(const ScalingParams& scaling = ScalingParams::standard());
+        ~ContractStateStore();
+
+        ContractStateStore(const ContractStateStore&) = delete;
+        ContractStateStore& operator=(const ContractStateStore&) = delete;
+
+        // Replaces the contents with the snapshot's records, flagged kStateRestored.
+        // Throws std::runtime_error if the file is unusable or its Greeks were stored with
+        // different scaling. Returns the number of contracts restored.
+        std::size_t restore(const std::string& path, bool verify = true);
+
+        // Copies the contract's state into `out`; false if the id is unknown.
+        bool get(std::uint64_t id, ContractState& out) const;
+
+        // Re-evaluates a contract from new inputs, with a known volatility or by solving
+        // for it from a market price. Adds the contract if it is new.
+        BatchStatus update(std::uint64_t id, bool call, double S, double K, double T, double r, double sigma, double q,
+                           double timestamp);
+        BatchStatus update_price(std::uint64_t id, bool call, double S, double K, double T, double r, double market_price,
+                                 double q, double timestamp);
+
+        // Re-evaluates up to `limit` restored contracts from their stored inputs, in
+        // parallel and outside the lock, for a background warm-up after restore(). Each
+        // contract's T first loses the time since its last update, (timestamp - updated) /
+        // year, in the caller's timestamp units. Contracts updated meanwhile keep their
+        // newer state. Returns how many it refreshed; 0 once every restored record is done.
+        std::size_t refresh_restored(std::size_t limit, double timestamp, double year, int threads = 0);
+
+        std::size_t size() const;
+        std::size_t restored() const;           // Contracts still flagged kStateRestored
+
+        // Writes a snapshot of every contract. The records are copied under a shared lock
+        // and written outside it, so updates only wait for the copy.
+        void save(const std::string& path) const;
+
+        // Calls save(path) every `interval` on a background thread until
+        // stop_snapshots() (or destruction). Failures are counted, not thrown.
+        void start_snapshots(const std::string& path, std::chrono::milliseconds interval);
+        void stop_snapshots();
+        std::uint64_t snapshots_written() const { return snapshots_written_.load(); }
+        std::uint64_t snapshot_failures() const { return snapshot_failures_.load(); }
+
+    private:
+        // Index entries below kLive point into the restored snapshot, the rest into live_.
+        static constexpr std::uint32_t kLive = 1u << 31;
+
+        const ContractState& at(std::uint32_t slot) const;
+        void store(std::uint64_t id, const ContractState& state);
+
+        ScalingParams scaling_;
+        mutable std::shared_mutex mutex_;
+        std::unordered_map<std::uint64_t, std::uint32_t> index_;
+        std::vector<ContractState> live_;
+        SnapshotView snapshot_;
+        std::size_t restored_ = 0;
+        std::mutex refresh_mutex_;
+        std::size_t refresh_cursor_ = 0;        // Next snapshot record for refresh_restored
+
+        std::thread writer_;
+        std::mutex writer_mutex_;
+        std::condition_variable writer_wake_;
+        bool writer_stop_ = false;
+        std::atomic<std::uint64_t> snapshots_written_{0};
+        std::atomic<std::uint64_t> snapshot_failures_{0};
+    };
+}
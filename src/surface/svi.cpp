@@ -0,0 +1,555 @@
+#include "surface/svi.h"
+#include "parallel/parallel.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace GreeksCalculator {
+    namespace {
+        constexpr int kParams = 5;
+        using Gradient = std::array<double, kParams>;   // d/d(a, b, rho, m, sigma)
+
+        // w, w' and w'' at k together with their parameter gradients.
+        struct SliceShape {
+            double w, w1, w2;
+            Gradient dw, dw1, dw2;
+        };
+
+        SliceShape shape(const SviParams& p, double k) {
+            double u = k - p.m;
+            double s2 = p.sigma * p.sigma;
+            double R = std::sqrt(u * u + s2);
+            double R3 = R * R * R;
+            double R5 = R3 * R * R;
+            SliceShape z;
+            z.w = p.a + p.b * (p.rho * u + R);
+            z.w1 = p.b * (p.rho + u / R);
+            z.w2 = p.b * s2 / R3;
+            z.dw = {1.0, p.rho * u + R, p.b * u, -p.b * (p.rho + u / R), p.b * p.sigma / R};
+            z.dw1 = {0.0, p.rho + u / R, p.b, -p.b * s2 / R3, -p.b * u * p.sigma / R3};
+            z.dw2 = {0.0, s2 / R3, 0.0, 3.0 * p.b * s2 * u / R5, p.b * p.sigma * (2.0 * R * R - 3.0 * s2) / R5};
+            return z;
+        }
+
+        double density_factor(const SliceShape& z, double k, Gradient* grad) {
+            double A = 1.0 - k * z.w1 / (2.0 * z.w);
+            double tail = 1.0 / z.w + 0.25;
+            double g = A * A - 0.25 * z.w1 * z.w1 * tail + 0.5 * z.w2;
+            if (grad) {
+                for (int j = 0; j < kParams; ++j) {
+                    double dA = -0.5 * k * (z.dw1[j] / z.w - z.w1 * z.dw[j] / (z.w * z.w));
+                    (*grad)[j] = 2.0 * A * dA - 0.5 * z.w1 * z.dw1[j] * tail + 0.25 * z.w1 * z.w1 * z.dw[j] / (z.w * z.w) + 0.5 * z.dw2[j];
+                }
+            }
+            return g;
+        }
+
+        // LM runs in unconstrained coordinates x = (a, log b, atanh rho, m, log sigma).
+        using Coordinates = std::array<double, kParams>;
+
+        SviParams from_coordinates(const Coordinates& x) {
+            return {x[0], std::exp(x[1]), std::tanh(x[2]), x[3], std::exp(x[4])};
+        }
+
+        Coordinates to_coordinates(const SviParams& p) {
+            double rho = std::max(-0.999999, std::min(0.999999, p.rho));
+            return {p.a, std::log(std::max(p.b, 1e-12)), std::atanh(rho), p.m, std::log(std::max(p.sigma, 1e-12))};
+        }
+
+        class SliceProblem {
+        public:
+            SliceProblem(const SliceQuotes& quotes, const SviParams* floor, const SviFitOptions& options)
+                : floor_(floor), penalty_(options.penalty) {
+                std::size_t n = quotes.strikes.size();
+                if (n == 0 || quotes.vols.size() != n || (!quotes.weights.empty() && quotes.weights.size() != n) ||
+                    !(quotes.T > 0.0) || !(quotes.forward > 0.0)) {
+                    throw std::invalid_argument("Invalid SVI slice quotes.");
+                }
+                k_.resize(n);
+                w_.resize(n);
+                weight_.assign(n, 1.0);
+                for (std::size_t i = 0; i < n; ++i) {
+                    k_[i] = std::log(quotes.strikes[i] / quotes.forward);
+                    w_[i] = quotes.vols[i] * quotes.vols[i] * quotes.T;
+                    if (!quotes.weights.empty()) {
+                        weight_[i] = quotes.weights[i];
+                    }
+                }
+                T_ = quotes.T;
+                auto range = std::minmax_element(k_.begin(), k_.end());
+                double lo = *range.first, hi = *range.second;
+                double pad = std::max(0.5 * (hi - lo), 0.1);
+                int points = std::max(options.grid_points, 2);
+                grid_.resize(static_cast<std::size_t>(points));
+                for (int j = 0; j < points; ++j) {
+                    grid_[static_cast<std::size_t>(j)] = lo - pad + (hi - lo + 2.0 * pad) * j / (points - 1);
+                }
+            }
+
+            std::size_t residual_count() const { return k_.size() + grid_.size() * (floor_ ? 2 : 1) + 2; }
+            const std::vector<double>& k() const { return k_; }
+            const std::vector<double>& w() const { return w_; }
+            double T() const { return T_; }
+            bool has_floor() const { return floor_ != nullptr; }
+
+            // Residuals and Jacobian rows with respect to the LM coordinates; returns the cost.
+            double evaluate(const Coordinates& x, std::vector<double>& r, std::vector<Gradient>* J) const {
+                SviParams p = from_coordinates(x);
+                const Gradient chain = {1.0, p.b, 1.0 - p.rho * p.rho, 1.0, p.sigma};
+                std::size_t row = 0;
+                auto emit = [&](double value, const Gradient& grad) {
+                    r[row] = value;
+                    if (J) {
+                        for (int j = 0; j < kParams; ++j) {
+                            (*J)[row][j] = grad[j] * chain[j];
+                        }
+                    }
+                    ++row;
+                };
+                const Gradient zero = {};
+
+                for (std::size_t i = 0; i < k_.size(); ++i) {
+                    SliceShape z = shape(p, k_[i]);
+                    Gradient g;
+                    for (int j = 0; j < kParams; ++j) {
+                        g[j] = weight_[i] * z.dw[j];
+                    }
+                    emit(weight_[i] * (z.w - w_[i]), g);
+                }
+
+                for (double k : grid_) {
+                    SliceShape z = shape(p, k);
+                    Gradient grad;
+                    double g = z.w > 0.0 ? density_factor(z, k, &grad) : 0.0;
+                    if (g < 0.0) {
+                        for (double& v : grad) {
+                            v *= -penalty_;
+                        }
+                        emit(-penalty_ * g, grad);
+                    } else {
+                        emit(0.0, zero);
+                    }
+                    if (floor_) {
+                        double gap = svi_total_variance(*floor_, k) - z.w;
+                        if (gap > 0.0) {
+                            Gradient grad_w;
+                            for (int j = 0; j < kParams; ++j) {
+                                grad_w[j] = -penalty_ * z.dw[j];
+                            }
+                            emit(penalty_ * gap, grad_w);
+                        } else {
+                            emit(0.0, zero);
+                        }
+                    }
+                }
+
+                // Minimum variance a + b sigma sqrt(1 - rho^2) >= 0.
+                double root = std::sqrt(1.0 - p.rho * p.rho);
+                double w_min = p.a + p.b * p.sigma * root;
+                if (w_min < 0.0) {
+                    emit(-penalty_ * w_min, {-penalty_, -penalty_ * p.sigma * root, penalty_ * p.b * p.sigma * p.rho / root, 0.0,
+                                             -penalty_ * p.b * root});
+                } else {
+                    emit(0.0, zero);
+                }
+
+                // Lee's moment bound on the wings: b (1 + |rho|) <= 2.
+                double lee = p.b * (1.0 + std::abs(p.rho)) - 2.0;
+                if (lee > 0.0) {
+                    emit(penalty_ * lee, {0.0, penalty_ * (1.0 + std::abs(p.rho)), penalty_ * p.b * (p.rho < 0.0 ? -1.0 : 1.0), 0.0, 0.0});
+                } else {
+                    emit(0.0, zero);
+                }
+
+                double cost = 0.0;
+                for (double v : r) {
+                    cost += v * v;
+                }
+                return 0.5 * cost;
+            }
+
+            // Largest amount by which the slice dips below the floor on the grid.
+            double calendar_gap(const SviParams& p) const {
+                double gap = 0.0;
+                for (double k : grid_) {
+                    gap = std::max(gap, svi_total_variance(*floor_, k) - svi_total_variance(p, k));
+                }
+                return gap;
+            }
+
+            // Lowest `a` that keeps the slice on or above the floor over the grid, given the other
+            // coordinates of x, and its gradient with respect to them.
+            double lowest_a(const Coordinates& x, Gradient* grad) const {
+                SviParams p = from_coordinates(x);
+                double lowest = -std::numeric_limits<double>::infinity();
+                double binding = 0.0;
+                for (double k : grid_) {
+                    double a = svi_total_variance(*floor_, k) - (svi_total_variance(p, k) - p.a);
+                    if (a > lowest) {
+                        lowest = a;
+                        binding = k;
+                    }
+                }
+                if (grad) {
+                    SliceShape z = shape(p, binding);
+                    const Gradient chain = {1.0, p.b, 1.0 - p.rho * p.rho, 1.0, p.sigma};
+                    (*grad)[0] = 0.0;
+                    for (int j = 1; j < kParams; ++j) {
+                        (*grad)[j] = -z.dw[j] * chain[j];
+                    }
+                }
+                return lowest;
+            }
+
+            // Bounded coordinates replace `a` by log(a - lowest_a), so no iterate crosses the floor.
+            Coordinates to_bounded(const Coordinates& x, double min_slack) const {
+                Coordinates y = x;
+                y[0] = std::log(std::max(x[0] - lowest_a(x, nullptr), min_slack));
+                return y;
+            }
+
+            Coordinates from_bounded(const Coordinates& y, Gradient* grad_a) const {
+                Coordinates x = y;
+                x[0] = lowest_a(y, grad_a) + std::exp(y[0]);
+                if (grad_a) {
+                    (*grad_a)[0] = std::exp(y[0]);
+                }
+                return x;
+            }
+
+            double evaluate_bounded(const Coordinates& y, std::vector<double>& r, std::vector<Gradient>* J) const {
+                Gradient grad_a;
+                double cost = evaluate(from_bounded(y, &grad_a), r, J);
+                if (J) {
+                    for (Gradient& row : *J) {
+                        double da = row[0];
+                        row[0] = da * grad_a[0];
+                        for (int j = 1; j < kParams; ++j) {
+                            row[j] += da * grad_a[j];
+                        }
+                    }
+                }
+                return cost;
+            }
+
+            bool arbitrage_free(const SviParams& p) const {
+                // A little slack so that penalty-enforced boundaries still count as satisfied.
+                constexpr double kSlack = 1e-8;
+                for (double k : grid_) {
+                    SliceShape z = shape(p, k);
+                    if (!(z.w > 0.0) || density_factor(z, k, nullptr) < -kSlack) {
+                        return false;
+                    }
+                    if (floor_ && svi_total_variance(*floor_, k) - z.w > kSlack) {
+                        return false;
+                    }
+                }
+                return true;
+            }
+
+        private:
+            std::vector<double> k_, w_, weight_, grid_;
+            double T_ = 0.0;
+            const SviParams* floor_;
+            double penalty_;
+        };
+
+        // Solves the 5x5 system A x = b by Gaussian elimination with partial pivoting.
+        bool solve(std::array<std::array<double, kParams>, kParams> A, Coordinates& b) {
+            for (int c = 0; c < kParams; ++c) {
+                int pivot = c;
+                for (int i = c + 1; i < kParams; ++i) {
+                    if (std::abs(A[i][c]) > std::abs(A[pivot][c])) {
+                        pivot = i;
+                    }
+                }
+                if (!(std::abs(A[pivot][c]) > 1e-300)) {
+                    return false;
+                }
+                std::swap(A[c], A[pivot]);
+                std::swap(b[c], b[pivot]);
+                for (int i = c + 1; i < kParams; ++i) {
+                    double f = A[i][c] / A[c][c];
+                    for (int j = c; j < kParams; ++j) {
+                        A[i][j] -= f * A[c][j];
+                    }
+                    b[i] -= f * b[c];
+                }
+            }
+            for (int c = kParams - 1; c >= 0; --c) {
+                for (int j = c + 1; j < kParams; ++j) {
+                    b[c] -= A[c][j] * b[j];
+                }
+                b[c] /= A[c][c];
+            }
+            return true;
+        }
+
+        // A positive `floor_slack` fits in the bounded coordinates, starting at least that far
+        // above the floor, so the fit never crosses it on the grid.
+        SviFit levenberg_marquardt(const SliceProblem& problem, const SviParams& start, const SviFitOptions& options,
+                                   double floor_slack = 0.0) {
+            const bool bounded = floor_slack > 0.0;
+            auto evaluate = [&](const Coordinates& x, std::vector<double>& r, std::vector<Gradient>* J) {
+                return bounded ? problem.evaluate_bounded(x, r, J) : problem.evaluate(x, r, J);
+            };
+            std::size_t m = problem.residual_count();
+            std::vector<double> r(m), trial_r(m);
+            std::vector<Gradient> J(m);
+            Coordinates x = to_coordinates(start);
+            if (bounded) {
+                x = problem.to_bounded(x, floor_slack);
+            }
+            double cost = evaluate(x, r, &J);
+            double lambda = 1e-3;
+
+            SviFit fit;
+            for (fit.iterations = 0; fit.iterations < options.max_iterations; ++fit.iterations) {
+                std::array<std::array<double, kParams>, kParams> JtJ = {};
+                Coordinates Jtr = {};
+                for (std::size_t i = 0; i < m; ++i) {
+                    for (int a = 0; a < kParams; ++a) {
+                        Jtr[a] -= J[i][a] * r[i];
+                        for (int b = a; b < kParams; ++b) {
+                            JtJ[a][b] += J[i][a] * J[i][b];
+                        }
+                    }
+                }
+                for (int a = 0; a < kParams; ++a) {
+                    for (int b = 0; b < a; ++b) {
+                        JtJ[a][b] = JtJ[b][a];
+                    }
+                }
+
+                bool improved = false;
+                while (lambda < 1e12) {
+                    auto A = JtJ;
+                    for (int a = 0; a < kParams; ++a) {
+                        A[a][a] += lambda * std::max(JtJ[a][a], 1e-12);
+                    }
+                    Coordinates step = Jtr;
+                    if (solve(A, step)) {
+                        Coordinates trial;
+                        for (int a = 0; a < kParams; ++a) {
+                            trial[a] = x[a] + step[a];
+                        }
+                        double trial_cost = evaluate(trial, trial_r, nullptr);
+                        if (std::isfinite(trial_cost) && trial_cost < cost) {
+                            double decrease = (cost - trial_cost) / std::max(cost, 1e-300);
+                            x = trial;
+                            cost = evaluate(x, r, &J);
+                            lambda = std::max(lambda * 0.3, 1e-12);
+                            improved = true;
+                            fit.converged = decrease < options.tolerance;
+                            break;
+                        }
+                    }
+                    lambda *= 10.0;
+                }
+                if (!improved) {
+                    fit.converged = true;    // No descent direction left: at a (local) minimum
+                }
+                if (fit.converged) {
+                    break;
+                }
+            }
+
+            fit.params = from_coordinates(bounded ? problem.from_bounded(x, nullptr) : x);
+            double gap = problem.has_floor() && !bounded ? problem.calendar_gap(fit.params) : 0.0;
+            if (gap > 0.0) {
+                // The penalty only shrinks the crossing. Rather than shift the slice up by what is
+                // left, refit with `a` bounded below by the floor so the other parameters adjust.
+                SviFit refit = levenberg_marquardt(problem, fit.params, options, gap);
+                refit.iterations += fit.iterations;
+                return refit;
+            }
+            double sum = 0.0;
+            for (std::size_t i = 0; i < problem.k().size(); ++i) {
+                double model = std::sqrt(std::max(svi_total_variance(fit.params, problem.k()[i]), 0.0) / problem.T());
+                double quote = std::sqrt(problem.w()[i] / problem.T());
+                sum += (model - quote) * (model - quote);
+            }
+            fit.rmse = std::sqrt(sum / static_cast<double>(problem.k().size()));
+            fit.arbitrage_free = problem.arbitrage_free(fit.params);
+            return fit;
+        }
+
+        // Cold starts: a flat smile through the ATM variance with three skew directions.
+        std::vector<SviParams> default_starts(const SliceProblem& problem) {
+            std::size_t atm = 0;
+            for (std::size_t i = 1; i < problem.k().size(); ++i) {
+                if (std::abs(problem.k()[i]) < std::abs(problem.k()[atm])) {
+                    atm = i;
+                }
+            }
+            double w_atm = problem.w()[atm];
+            std::vector<SviParams> starts;
+            for (double rho : {-0.5, 0.0, 0.5}) {
+                SviParams p;
+                p.b = 0.1;
+                p.sigma = 0.1;
+                p.rho = rho;
+                p.m = 0.0;
+                p.a = w_atm - p.b * p.sigma;
+                starts.push_back(p);
+            }
+            return starts;
+        }
+    }
+
+    double svi_total_variance(const SviParams& p, double k) {
+        double u = k - p.m;
+        return p.a + p.b * (p.rho * u + std::sqrt(u * u + p.sigma * p.sigma));
+    }
+
+    double svi_density_factor(const SviParams& p, double k) {
+        return density_factor(shape(p, k), k, nullptr);
+    }
+
+    SviParams ssvi_slice(double theta, double phi, double rho) {
+        double root = std::sqrt(1.0 - rho * rho);
+        return {0.5 * theta * (1.0 - rho * rho), 0.5 * theta * phi, rho, -rho / phi, root / phi};
+    }
+
+    SviFit fit_svi_slice(const SliceQuotes& quotes, const SviParams* warm_start, const SviParams* floor, const SviFitOptions& options) {
+        SliceProblem problem(quotes, floor, options);
+        if (warm_start) {
+            return levenberg_marquardt(problem, *warm_start, options);
+        }
+        SviFit best;
+        double best_score = std::numeric_limits<double>::infinity();
+        for (const SviParams& start : default_starts(problem)) {
+            SviFit fit = levenberg_marquardt(problem, start, options);
+            // Prefer arbitrage-free fits, then the lowest error.
+            double score = fit.rmse + (fit.arbitrage_free ? 0.0 : 1.0);
+            if (score < best_score) {
+                best_score = score;
+                best = fit;
+            }
+        }
+        return best;
+    }
+
+    SviSurface::SviSurface(std::vector<Slice> slices) : slices_(std::move(slices)) {
+        std::sort(slices_.begin(), slices_.end(), [](const Slice& a, const Slice& b) { return a.T < b.T; });
+    }
+
+    double SviSurface::forward(double T) const {
+        if (T <= slices_.front().T) {
+            return slices_.front().forward;
+        }
+        if (T >= slices_.back().T) {
+            return slices_.back().forward;
+        }
+        auto hi = std::upper_bound(slices_.begin(), slices_.end(), T, [](double t, const Slice& s) { return t < s.T; });
+        auto lo = hi - 1;
+        double f = (T - lo->T) / (hi->T - lo->T);
+        return std::exp((1.0 - f) * std::log(lo->forward) + f * std::log(hi->forward));
+    }
+
+    double SviSurface::total_variance(double K, double T) const {
+        if (slices_.empty() || !(T > 0.0) || !(K > 0.0)) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        double k = std::log(K / forward(T));
+        if (T <= slices_.front().T) {
+            return svi_total_variance(slices_.front().params, k) * T / slices_.front().T;
+        }
+        if (T >= slices_.back().T) {
+            return svi_total_variance(slices_.back().params, k) * T / slices_.back().T;
+        }
+        auto hi = std::upper_bound(slices_.begin(), slices_.end(), T, [](double t, const Slice& s) { return t < s.T; });
+        auto lo = hi - 1;
+        double f = (T - lo->T) / (hi->T - lo->T);
+        return (1.0 - f) * svi_total_variance(lo->params, k) + f * svi_total_variance(hi->params, k);
+    }
+
+    double SviSurface::volatility(double K, double T) const {
+        double w = total_variance(K, T);
+        return w > 0.0 ? std::sqrt(w / T) : std::numeric_limits<double>::quiet_NaN();
+    }
+
+    std::vector<SurfaceFit> calibrate_surfaces(const std::vector<SurfaceQuotes>& underlyings, const std::vector<SurfaceFit>* previous,
+                                               const SviFitOptions& options, int threads) {
+        if (previous && previous->size() != underlyings.size()) {
+            previous = nullptr;
+        }
+
+        std::vector<std::pair<std::size_t, std::size_t>> slices;
+        std::vector<SurfaceFit> result(underlyings.size());
+        for (std::size_t u = 0; u < underlyings.size(); ++u) {
+            result[u].fits.resize(underlyings[u].expiries.size());
+            for (std::size_t e = 0; e < underlyings[u].expiries.size(); ++e) {
+                slices.emplace_back(u, e);
+            }
+        }
+
+        auto warm_start = [&](std::size_t u, double T) -> const SviParams* {
+            if (!previous) {
+                return nullptr;
+            }
+            for (const auto& slice : (*previous)[u].surface.slices()) {
+                if (std::abs(slice.T - T) < 1.0 / 365.0) {
+                    return &slice.params;
+                }
+            }
+            return nullptr;
+        };
+
+        parallel_for(slices.size(), threads, [&](std::size_t i) {
+            std::size_t u = slices[i].first, e = slices[i].second;
+            const SliceQuotes& quotes = underlyings[u].expiries[e];
+            result[u].fits[e] = fit_svi_slice(quotes, warm_start(u, quotes.T), nullptr, options);
+        });
+
+        // Calendar pass in expiry order; each refit only depends on the already-final slice before it.
+        parallel_for(underlyings.size(), threads, [&](std::size_t u) {
+            const auto& expiries = underlyings[u].expiries;
+            std::vector<std::size_t> order(expiries.size());
+            for (std::size_t e = 0; e < order.size(); ++e) {
+                order[e] = e;
+            }
+            std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return expiries[a].T < expiries[b].T; });
+
+            std::vector<SviSurface::Slice> surface;
+            for (std::size_t j = 0; j < order.size(); ++j) {
+                std::size_t e = order[j];
+                SviFit& fit = result[u].fits[e];
+                if (j > 0) {
+                    const SviParams& floor = result[u].fits[order[j - 1]].params;
+                    SliceProblem check(expiries[e], &floor, options);
+                    if (!check.arbitrage_free(fit.params)) {
+                        SviFit repaired = fit_svi_slice(expiries[e], &fit.params, &floor, options);
+                        repaired.iterations += fit.iterations;
+                        fit = repaired;
+                    }
+                }
+                surface.push_back({expiries[e].T, expiries[e].forward, fit.params});
+            }
+            result[u].surface = SviSurface(std::move(surface));
+        });
+        return result;
+    }
+
+    namespace {
+        struct SurfaceKernel {
+            const SviSurface& surface;
+            BsmKernel exact;
+
+            bool valid(double S, double K, double T, double r, double, double q) const {
+                return inputs_valid(S, K, T, r, surface.volatility(K, T), q);
+            }
+
+            void operator()(GreekMask columns, bool call, double S, double K, double T, double r, double, double q, Greeks& g) const {
+                exact(columns, call, S, K, T, r, surface.volatility(K, T), q, g);
+            }
+        };
+    }
+
+    std::size_t surface_batch_greeks(const SviSurface& surface, const BatchInputs& in, const BatchOutputs& out,
+                                     const ScalingParams& scaling, int threads) {
+        return batch_evaluate(in, out, SurfaceKernel{surface, BsmKernel{scaling}}, threads);
+    }
+}
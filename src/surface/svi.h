@@ -0,0 +1,104 @@
+#pragma once
+#include "Greeks.h"
+#include "batch/batch.h"
+#include <cstddef>
+#include <vector>
+
+namespace GreeksCalculator {
+    // Raw SVI total implied variance w(k) = a + b * (rho * (k - m) + sqrt((k - m)^2 + sigma^2))
+    // in log-forward-moneyness k = log(K / F).
+    struct SviParams {
+        double a = 0.0;
+        double b = 0.1;
+        double rho = 0.0;
+        double m = 0.0;
+        double sigma = 0.1;
+    };
+
+    double svi_total_variance(const SviParams& p, double k);
+
+    // Gatheral's density factor g(k); the slice is free of butterfly arbitrage where g >= 0.
+    double svi_density_factor(const SviParams& p, double k);
+
+    // Raw SVI form of the SSVI slice with ATM total variance theta, curvature phi and correlation rho.
+    SviParams ssvi_slice(double theta, double phi, double rho);
+
+    // Implied volatility quotes for one expiry, e.g. from calculate_implied_volatility.
+    struct SliceQuotes {
+        double T = 0.0;
+        double forward = 0.0;
+        std::vector<double> strikes;
+        std::vector<double> vols;
+        std::vector<double> weights;    // Optional; empty means equal weights
+    };
+
+    struct SviFitOptions {
+        int max_iterations = 100;
+        double tolerance = 1e-12;       // Relative cost decrease that ends the fit
+        double penalty = 10.0;          // Weight of the no-arbitrage penalty residuals
+        int grid_points = 41;           // Constraint grid over the quoted range plus half its width each side
+    };
+
+    struct SviFit {
+        SviParams params;
+        double rmse = std::numeric_limits<double>::quiet_NaN();   // In implied volatility
+        int iterations = 0;
+        bool converged = false;
+        bool arbitrage_free = false;    // Butterfly (and calendar, if a floor slice was given) on the grid
+    };
+
+    // Levenberg-Marquardt fit of one slice in total variance with analytic Jacobians. Butterfly
+    // (g(k) >= 0), non-negative variance and Lee's wing bound are enforced through penalty
+    // residuals, as is w(k) >= floor(k) when the previous expiry's slice is passed as `floor`.
+    // If the penalized fit still dips below the floor, it is refit with `a` bounded below by it.
+    // `warm_start` (e.g. the last fit of the same expiry) replaces the default multi-start.
+    SviFit fit_svi_slice(const SliceQuotes& quotes, const SviParams* warm_start = nullptr, const SviParams* floor = nullptr,
+                         const SviFitOptions& options = SviFitOptions{});
+
+    // Calibrated slices of one underlying, interpolated linearly in total variance along T at
+    // fixed log-forward-moneyness, which preserves the absence of calendar arbitrage.
+    class SviSurface {
+    public:
+        struct Slice {
+            double T;
+            double forward;
+            SviParams params;
+        };
+
+        SviSurface() = default;
+        explicit SviSurface(std::vector<Slice> slices);
+
+        // Sticky strike: moneyness is taken against the calibration forwards, so sigma(K, T)
+        // does not move with spot. Returns NaN for an empty surface or T <= 0.
+        double total_variance(double K, double T) const;
+        double volatility(double K, double T) const;
+
+        const std::vector<Slice>& slices() const { return slices_; }
+
+    private:
+        double forward(double T) const;
+
+        std::vector<Slice> slices_;
+    };
+
+    struct SurfaceQuotes {
+        std::vector<SliceQuotes> expiries;
+    };
+
+    struct SurfaceFit {
+        SviSurface surface;
+        std::vector<SviFit> fits;       // Same order as the quoted expiries
+    };
+
+    // Fits every expiry of every underlying in parallel, then repairs calendar arbitrage per
+    // underlying (in parallel across underlyings) by refitting any slice that dips below the
+    // previous expiry with that slice as a floor. `previous` warm-starts each slice from the
+    // fit of the same underlying whose expiry is within a day.
+    std::vector<SurfaceFit> calibrate_surfaces(const std::vector<SurfaceQuotes>& underlyings,
+                                               const std::vector<SurfaceFit>* previous = nullptr,
+                                               const SviFitOptions& options = SviFitOptions{}, int threads = 0);
+
+    // batch_greeks with each row's volatility read from the surface at (K, T); `in.sigma` is ignored.
+    std::size_t surface_batch_greeks(const SviSurface& surface, const BatchInputs& in, const BatchOutputs& out,
+                                     const ScalingParams& scaling = ScalingParams::standard(), int threads = 0);
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_all.hpp>
+#include "batch/batch.h"
+#include "capi/greeks_c.h"
+#include "Greeks.h"
+#include <vector>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Batch Greek Engine", "[batch]") {
+    std::vector<double> S = {90.0, 100.0, 110.0, -1.0, 100.0};
+    std::vector<double> K = {100.0, 100.0, 100.0, 100.0, 95.0};
+    std::vector<double> T = {0.5, 1.0, 0.25, 1.0, 0.1};
+    std::vector<double> sigma = {0.2, 0.3, 0.25, 0.2, 0.4};
+    std::vector<std::uint8_t> call = {1, 0, 1, 1, 0};
+    double r = 0.05, q = 0.01;
+    std::size_t n = S.size();
+
+    BatchInputs in;
+    in.count = n;
+    in.call = {call.data(), 1};
+    in.S = {S.data(), 1};
+    in.K = {K.data(), 1};
+    in.T = {T.data(), 1};
+    in.r = {&r, 0};
+    in.sigma = {sigma.data(), 1};
+    in.q = {&q, 0};
+
+    SECTION("Selected columns match calculate_all") {
+        std::vector<double> delta(n), gamma(n), pounce(n);
+        std::vector<std::int32_t> status(n);
+        BatchOutputs out;
+        out.columns = greek_bit(GreekColumn::Delta) | greek_bit(GreekColumn::Gamma) | greek_bit(GreekColumn::Pounce);
+        out.greeks[static_cast<int>(GreekColumn::Delta)] = {delta.data(), 1};
+        out.greeks[static_cast<int>(GreekColumn::Gamma)] = {gamma.data(), 1};
+        out.greeks[static_cast<int>(GreekColumn::Pounce)] = {pounce.data(), 1};
+        out.status = {status.data(), 1};
+
+        REQUIRE(batch_greeks(in, out, ScalingParams::standard(), 3) == 1);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i == 3) {
+                REQUIRE(status[i] == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+                REQUIRE(std::isnan(delta[i]));
+                continue;
+            }
+            Greeks g = calculate_all(call[i], S[i], K[i], T[i], r, sigma[i], q);
+            REQUIRE(status[i] == 0);
+            REQUIRE(delta[i] == g.delta);
+            REQUIRE(gamma[i] == g.gamma);
+            REQUIRE((pounce[i] == g.pounce || (std::isnan(pounce[i]) && std::isnan(g.pounce))));
+        }
+    }
+
+    SECTION("Implied volatility round trip") {
+        std::vector<double> price(n), iv(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            price[i] = S[i] > 0.0 ? calculate_price(call[i], S[i], K[i], T[i], r, sigma[i], q) : 1.0;
+        }
+        std::vector<std::int32_t> status(n);
+        batch_implied_volatility(in, {price.data(), 1}, {iv.data(), 1}, {status.data(), 1}, 2);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i != 3) {
+                REQUIRE(std::abs(iv[i] - sigma[i]) < 1e-5);
+            }
+        }
+        REQUIRE(status[3] == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+    }
+
+    SECTION("C ABI with interleaved output") {
+        oqg_inputs cin = {};
+        cin.count = n;
+        cin.is_call = call.data(); cin.is_call_stride = 1;
+        cin.spot = S.data(); cin.spot_stride = 1;
+        cin.strike = K.data(); cin.strike_stride = 1;
+        cin.expiry = T.data(); cin.expiry_stride = 1;
+        cin.rate = &r; cin.rate_stride = 0;
+        cin.vol = sigma.data(); cin.vol_stride = 1;
+
+        // Row-major (n x 2) output matrix: price and vega share one buffer.
+        std::vector<double> table(2 * n);
+        std::vector<std::int32_t> status(n);
+        oqg_outputs cout = {};
+        cout.columns = OQG_COLUMN_BIT(OQG_PRICE) | OQG_COLUMN_BIT(OQG_VEGA);
+        cout.data[OQG_PRICE] = table.data(); cout.stride[OQG_PRICE] = 2;
+        cout.data[OQG_VEGA] = table.data() + 1; cout.stride[OQG_VEGA] = 2;
+        cout.status = status.data(); cout.status_stride = 1;
+
+        REQUIRE(oqg_greeks(&cin, &cout, nullptr, 0) == OQG_PARTIAL);
+        REQUIRE(status[3] == OQG_STATUS_INVALID_INPUT);
+        REQUIRE(table[2 * 1] == calculate_price(false, 100.0, 100.0, 1.0, r, 0.3, 0.0));
+        REQUIRE(table[2 * 1 + 1] == calculate_vega(100.0, 100.0, 1.0, r, 0.3, 0.0));
+
+        cout.columns |= OQG_COLUMN_BIT(OQG_GAMMA);
+        REQUIRE(oqg_greeks(&cin, &cout, nullptr, 0) == OQG_ERROR_ARGUMENT);
+        REQUIRE(oqg_greeks(nullptr, &cout, nullptr, 0) == OQG_ERROR_ARGUMENT);
+        REQUIRE(std::string(oqg_column_name(OQG_DUAL_RHO)) == "dual_rho");
+    }
+}
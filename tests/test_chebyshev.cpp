@@ -0,0 +1,167 @@
+#include <catch2/catch_all.hpp>
+#include "approx/chebyshev.h"
+#include "Greeks.h"
+#include "math/cdf.h"
+#include "math/pdf.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Chebyshev Black Table", "[chebyshev]") {
+    ChebyshevTableSpec spec;
+    spec.cells = 256;
+    ChebyshevBlackTable table = ChebyshevBlackTable::build(spec);
+    double tol = std::max(table.max_error(TableFunction::Cdf), table.max_error(TableFunction::Pdf));
+    REQUIRE(tol < 1e-12);
+
+    SECTION("Greeks match the exact formulas") {
+        double r = 0.03, q = 0.01;
+        for (double K : {70.0, 95.0, 100.0, 120.0, 150.0}) {
+            for (double T : {0.05, 0.5, 2.0}) {
+                for (double sigma : {0.1, 0.3, 0.8}) {
+                    for (bool call : {true, false}) {
+                        Greeks a = approx_greeks(table, call, 100.0, K, T, r, sigma, q);
+                        REQUIRE(std::abs(a.price - calculate_price(call, 100.0, K, T, r, sigma, q)) < 300.0 * tol);
+                        REQUIRE(std::abs(a.delta - calculate_delta(call, 100.0, K, T, r, sigma, q)) < 10.0 * tol);
+                        REQUIRE(std::abs(a.gamma - calculate_gamma(100.0, K, T, r, sigma, q)) < 1e-10);
+                        REQUIRE(std::abs(a.vega - calculate_vega(100.0, K, T, r, sigma, q)) < 1e-10);
+                        REQUIRE(std::abs(a.volga - calculate_volga(100.0, K, T, r, sigma, q)) < 1e-9);
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("The error bound holds for every table resolution") {
+        for (int cells : {16, 64, 256}) {
+            for (int degree : {3, 5, 8}) {
+                ChebyshevTableSpec s;
+                s.cells = cells;
+                s.degree = degree;
+                ChebyshevBlackTable t = ChebyshevBlackTable::build(s);
+                double bound_cdf = t.max_error(TableFunction::Cdf), bound_pdf = t.max_error(TableFunction::Pdf);
+                double worst_cdf = 0.0, worst_pdf = 0.0;
+                bool inside = true;
+                // With v = 1, d1 sweeps [-8, 9] and d2 = d1 - 1 covers the rest of the domain.
+                for (int i = 0; i <= 100000; ++i) {
+                    double k = -8.5 + 17.0 * i / 100000.0;
+                    double d1 = k / 1.0 + 0.5, d2 = d1 - 1.0;
+                    ChebyshevBlackTable::Values v{};
+                    inside = t.evaluate(k, 1.0, v) && inside;
+                    worst_cdf = std::max({worst_cdf, std::abs(v.cdf_d1 - normal_cdf(d1)), std::abs(v.cdf_d2 - normal_cdf(d2))});
+                    worst_pdf = std::max(worst_pdf, std::abs(v.pdf_d1 - normal_pdf(d1)));
+                }
+                REQUIRE(inside);
+                REQUIRE(worst_cdf <= bound_cdf);
+                REQUIRE(worst_pdf <= bound_pdf);
+                // A bound, not an estimate, but not a loose one either.
+                REQUIRE(bound_cdf < 100.0 * std::max(worst_cdf, 1e-16));
+            }
+        }
+    }
+
+    SECTION("Deep out-of-the-money puts keep their relative accuracy") {
+        // The table reads N(-d) directly; 1 - N(d) would lose about 2% of this put's price.
+        double S = 100.0, K = 50.0, T = 0.25, sigma = 0.2;
+        double v = sigma * std::sqrt(T);
+        double d1 = std::log(S / K) / v + 0.5 * v, d2 = d1 - v;
+        double price = K * normal_cdf(-d2) - S * normal_cdf(-d1);
+        double delta = -normal_cdf(-d1);
+        Greeks a = approx_greeks(table, false, S, K, T, 0.0, sigma);
+        REQUIRE(price < 1e-10);
+        REQUIRE(std::abs(a.price - price) < 1e-6 * price);
+        REQUIRE(std::abs(a.delta - delta) < 1e-6 * std::abs(delta));
+        REQUIRE(std::abs(a.epsilon - T * S * normal_cdf(-d1) / 100.0) < 1e-6 * std::abs(a.epsilon));
+    }
+
+    SECTION("Falls back to exact outside the domain") {
+        REQUIRE_FALSE(table.contains(-30.0, 0.2));
+        Greeks a = approx_greeks(table, true, 100.0, 0.1, 1.0, 0.0, 0.1);
+        REQUIRE(a.price == calculate_price(true, 100.0, 0.1, 1.0, 0.0, 0.1));
+        REQUIRE(a.delta == calculate_delta(true, 100.0, 0.1, 1.0, 0.0, 0.1));
+    }
+
+    SECTION("Save and load round trip") {
+        std::string path = "chebyshev_table_test.bin";
+        table.save(path);
+        ChebyshevBlackTable loaded = ChebyshevBlackTable::load(path);
+        ChebyshevBlackTable::Values a{}, b{};
+        REQUIRE(table.evaluate(0.05, 0.3, a));
+        REQUIRE(loaded.evaluate(0.05, 0.3, b));
+        REQUIRE(a.cdf_d1 == b.cdf_d1);
+        REQUIRE(a.pdf_d1 == b.pdf_d1);
+        REQUIRE(loaded.max_error(TableFunction::Cdf) == table.max_error(TableFunction::Cdf));
+
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(200);
+            file.put('\x7f');
+        }
+        REQUIRE_THROWS_AS(ChebyshevBlackTable::load(path), std::runtime_error);
+        std::remove(path.c_str());
+    }
+
+    SECTION("Batch engine matches the scalar approximation") {
+        std::vector<double> K = {80.0, 100.0, 125.0};
+        std::vector<double> price(3), vanna(3), speed(3);
+        double S = 100.0, T = 0.75, r = 0.02, sigma = 0.25;
+
+        BatchInputs in;
+        in.count = K.size();
+        in.S = {&S, 0};
+        in.K = {K.data(), 1};
+        in.T = {&T, 0};
+        in.r = {&r, 0};
+        in.sigma = {&sigma, 0};
+
+        BatchOutputs out;
+        out.columns = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Vanna) | greek_bit(GreekColumn::Speed);
+        out.greeks[static_cast<int>(GreekColumn::Price)] = {price.data(), 1};
+        out.greeks[static_cast<int>(GreekColumn::Vanna)] = {vanna.data(), 1};
+        out.greeks[static_cast<int>(GreekColumn::Speed)] = {speed.data(), 1};
+
+        REQUIRE(approx_batch_greeks(table, in, out, ScalingParams::standard(), 2) == 0);
+        for (std::size_t i = 0; i < K.size(); ++i) {
+            Greeks a = approx_greeks(table, true, S, K[i], T, r, sigma);
+            REQUIRE(price[i] == a.price);
+            REQUIRE(vanna[i] == a.vanna);
+            REQUIRE(speed[i] == calculate_speed(S, K[i], T, r, sigma));
+        }
+    }
+
+    SECTION("Requests for every column still use the table") {
+        std::vector<double> K = {80.0, 100.0, 125.0};
+        std::vector<double> storage(K.size() * kGreekColumnCount);
+        double S = 100.0, T = 0.75, r = 0.02, sigma = 0.25;
+
+        BatchInputs in;
+        in.count = K.size();
+        in.S = {&S, 0};
+        in.K = {K.data(), 1};
+        in.T = {&T, 0};
+        in.r = {&r, 0};
+        in.sigma = {&sigma, 0};
+
+        BatchOutputs out;
+        out.columns = kAllGreeks;
+        for (int c = 0; c < kGreekColumnCount; ++c) {
+            out.greeks[c] = {storage.data() + c * K.size(), 1};
+        }
+        REQUIRE(approx_batch_greeks(table, in, out) == 0);
+        const double* price = storage.data() + static_cast<int>(GreekColumn::Price) * K.size();
+        const double* delta = storage.data() + static_cast<int>(GreekColumn::Delta) * K.size();
+        const double* speed = storage.data() + static_cast<int>(GreekColumn::Speed) * K.size();
+        for (std::size_t i = 0; i < K.size(); ++i) {
+            Greeks a = approx_greeks(table, true, S, K[i], T, r, sigma);
+            REQUIRE(price[i] == a.price);
+            REQUIRE(delta[i] == a.delta);
+            REQUIRE(price[i] != calculate_price(true, S, K[i], T, r, sigma));
+            REQUIRE(speed[i] == calculate_speed(S, K[i], T, r, sigma));
+        }
+    }
+}
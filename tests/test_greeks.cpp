@@ -1,5 +1,6 @@
 #include <catch2/catch_all.hpp>
 #include "bsm/full.h"
+#include "bsm/spot_derivatives.h"
 #include "math/maths.h"
 
 using namespace GreeksCalculator;
@@ -72,4 +73,117 @@ TEST_CASE("Greeks Calculations", "[greeks]") {
         // Test that intraday and standard Greeks have same delta (no scaling)
         REQUIRE(std::abs(g_intraday.delta - g_call.delta) < tol);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Spot Derivative Recurrence", "[greeks]") {
+    double S = 105.0, K = 100.0, T = 0.7, r = 0.04, sigma = 0.3, q = 0.015;
+    const int order = 8;
+    double spot[order + 1], vol[order + 1], time[order + 1];
+
+    SECTION("Low orders match the closed forms") {
+        ScalingParams raw = ScalingParams::no_scaling();
+        spot_derivatives(true, S, K, T, r, sigma, q, order, spot, vol, time);
+        REQUIRE(std::abs(spot[0] - calculate_price(true, S, K, T, r, sigma, q)) < 1e-12);
+        REQUIRE(std::abs(spot[1] - calculate_delta(true, S, K, T, r, sigma, q)) < 1e-14);
+        REQUIRE(std::abs(spot[2] - calculate_gamma(S, K, T, r, sigma, q)) < 1e-14);
+        REQUIRE(std::abs(spot[3] - calculate_speed(S, K, T, r, sigma, q)) < 1e-14);
+        REQUIRE(std::abs(vol[0] - calculate_vega(S, K, T, r, sigma, q, raw)) < 1e-12);
+        REQUIRE(std::abs(vol[1] - calculate_vanna(S, K, T, r, sigma, q, raw)) < 1e-14);
+        REQUIRE(std::abs(vol[2] - 100.0 * calculate_zomma(S, K, T, r, sigma, q)) < 1e-14);
+        REQUIRE(std::abs(time[1] + calculate_charm(true, S, K, T, r, sigma, q, raw)) < 1e-14);
+    }
+
+    SECTION("Higher orders match finite differences of the order below") {
+        for (bool call : {true, false}) {
+            spot_derivatives(call, S, K, T, r, sigma, q, order, spot, vol, time);
+            auto at = [&](double s, double t, double v, int n) { return spot_derivative(call, s, K, t, r, v, q, n); };
+            for (int n = 0; n <= order; ++n) {
+                double dv = (at(S, T, sigma + 1e-5, n) - at(S, T, sigma - 1e-5, n)) / 2e-5;
+                double dt = (at(S, T + 1e-5, sigma, n) - at(S, T - 1e-5, sigma, n)) / 2e-5;
+                REQUIRE(std::abs(vol[n] - dv) < 1e-6 * std::abs(vol[n]));
+                REQUIRE(std::abs(time[n] - dt) < 1e-6 * std::abs(time[n]));
+                if (n > 0) {
+                    double h = 1e-3;
+                    double ds = (at(S + h, T, sigma, n - 1) - at(S - h, T, sigma, n - 1)) / (2.0 * h);
+                    REQUIRE(std::abs(spot[n] - ds) < 1e-5 * std::abs(spot[n]));
+                }
+            }
+        }
+    }
+
+    SECTION("calculate_all uses the recurrence for snap, jounce and pounce") {
+        Greeks g = calculate_all(true, S, K, T, r, sigma, q);
+        spot_derivatives(true, S, K, T, r, sigma, q, 6, spot);
+        REQUIRE(g.snap == spot[4]);
+        REQUIRE(g.jounce == spot[5]);
+        REQUIRE(g.pounce == spot[6]);
+        REQUIRE(calculate_snap(S, K, T, r, sigma, q) == spot[4]);
+        REQUIRE_THROWS_AS(spot_derivatives(true, S, K, T, r, sigma, q, kMaxSpotOrder + 1, spot), std::invalid_argument);
+    }
+
+    SECTION("Greeks built on snap, jounce and pounce") {
+        // Pinned after the switch to the recurrence: crackle and pop scale snap, quintema
+        // jounce and hexema pounce, so they moved with them (quintema and hexema change sign).
+        Greeks g = calculate_all(true, S, K, T, r, sigma, q);
+        const double expected[4] = {2.387161964362e-07, 1.362643616279e-06, -4.952947607520e-06, -1.889287732530e-06};
+        const double all[4] = {g.crackle, g.pop, g.quintema, g.hexema};
+        const double named[4] = {calculate_crackle(S, K, T, r, sigma, q), calculate_pop(S, K, T, r, sigma, q),
+                                 calculate_quintema(S, K, T, r, sigma, q), calculate_hexema(S, K, T, r, sigma, q)};
+        for (int i = 0; i < 4; ++i) {
+            REQUIRE(std::abs(all[i] - expected[i]) < 1e-10 * std::abs(expected[i]));
+            REQUIRE(std::abs(named[i] - expected[i]) < 1e-10 * std::abs(expected[i]));
+        }
+    }
+
+    SECTION("Orders below first are skipped") {
+        double partial[order + 1];
+        spot_derivatives(false, S, K, T, r, sigma, q, order, spot);
+        for (double& x : partial) {
+            x = -1.0;
+        }
+        spot_derivatives(false, S, K, T, r, sigma, q, order, partial, nullptr, nullptr, 4);
+        for (int n = 0; n <= order; ++n) {
+            REQUIRE(partial[n] == (n < 4 ? -1.0 : spot[n]));
+        }
+    }
+}
+
+TEST_CASE("Time and rate Greeks with dividends", "[greeks]") {
+    double S = 95.0, K = 100.0, T = 0.6, r = 0.04, sigma = 0.25, q = 0.03;
+    ScalingParams raw = ScalingParams::no_scaling();
+    const double h = 1e-5;
+
+    SECTION("Theta is minus the time derivative of the price") {
+        for (bool call : {true, false}) {
+            double dT = (calculate_price(call, S, K, T + h, r, sigma, q) - calculate_price(call, S, K, T - h, r, sigma, q)) / (2.0 * h);
+            double theta = calculate_theta(call, S, K, T, r, sigma, q, raw);
+            REQUIRE(std::abs(theta + dT) < 1e-7 * std::abs(dT));
+            REQUIRE(std::abs(calculate_theta(call, S, K, T, r, sigma, q) - theta / 365.0) < 1e-15);
+        }
+        // Put-call parity: theta_call - theta_put = q S e^(-qT) - r K e^(-rT).
+        double parity = q * S * std::exp(-q * T) - r * K * std::exp(-r * T);
+        REQUIRE(std::abs(calculate_theta(true, S, K, T, r, sigma, q, raw) - calculate_theta(false, S, K, T, r, sigma, q, raw) - parity) < 1e-13);
+    }
+
+    SECTION("Charm, veta and vera match differences of delta, vega and rho") {
+        for (bool call : {true, false}) {
+            double dT = (calculate_delta(call, S, K, T + h, r, sigma, q) - calculate_delta(call, S, K, T - h, r, sigma, q)) / (2.0 * h);
+            double charm = calculate_charm(call, S, K, T, r, sigma, q, raw);
+            REQUIRE(std::abs(charm + dT) < 1e-7 * std::abs(dT));
+
+            double drho = (calculate_rho(call, S, K, T, r, sigma + h, q, raw) - calculate_rho(call, S, K, T, r, sigma - h, q, raw)) / (2.0 * h);
+            REQUIRE(std::abs(calculate_vera(S, K, T, r, sigma, q, raw) - drho) < 1e-7 * std::abs(drho));
+        }
+        // Charm is the same for calls and puts up to the dividend term: delta_call - delta_put = e^(-qT).
+        double parity = q * std::exp(-q * T);
+        REQUIRE(std::abs(calculate_charm(true, S, K, T, r, sigma, q, raw) - calculate_charm(false, S, K, T, r, sigma, q, raw) - parity) < 1e-13);
+
+        double dvega = (calculate_vega(S, K, T + h, r, sigma, q, raw) - calculate_vega(S, K, T - h, r, sigma, q, raw)) / (2.0 * h);
+        double veta = calculate_veta(S, K, T, r, sigma, q, raw);
+        REQUIRE(std::abs(veta + dvega) < 1e-7 * std::abs(dvega));
+        REQUIRE(std::abs(calculate_veta(S, K, T, r, sigma, q) - veta / 365.0 / 100.0) < 1e-15);
+        // Vera is also the rate derivative of vega.
+        double dr = (calculate_vega(S, K, T, r + h, sigma, q, raw) - calculate_vega(S, K, T, r - h, sigma, q, raw)) / (2.0 * h);
+        REQUIRE(std::abs(calculate_vera(S, K, T, r, sigma, q, raw) - dr) < 1e-7 * std::abs(dr));
+    }
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_all.hpp>
+#include "hedge/simulator.h"
+#include "Greeks.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Delta-hedging simulator", "[hedge]") {
+    HedgeOption option;
+    option.K = 100.0;
+    option.T = 0.5;
+    option.r = 0.03;
+    option.q = 0.01;
+    option.sigma = 0.2;
+    HedgePolicy policy;
+    HedgeCosts costs;
+    GbmPathParams gbm;
+    gbm.mu = 0.08;
+    gbm.sigma = 0.2;
+    gbm.paths = 2000;
+    gbm.seed = 7;
+
+    SECTION("Hedging error shrinks with the rehedge frequency") {
+        gbm.steps = 25;
+        HedgeReport coarse = simulate_hedging(option, policy, costs, gbm, 2);
+        gbm.steps = 400;
+        HedgeReport fine = simulate_hedging(option, policy, costs, gbm, 2);
+        REQUIRE(fine.path_steps == 2000u * 400u);
+        // The error of daily-style hedging falls like 1 / sqrt(steps).
+        REQUIRE(fine.pnl.std_dev < 0.35 * coarse.pnl.std_dev);
+        REQUIRE(std::abs(fine.pnl.mean) < 4.0 * fine.pnl.std_dev / std::sqrt(2000.0));
+        REQUIRE(fine.tracking_error.mean < coarse.tracking_error.mean);
+        REQUIRE(fine.trades.max == 400.0);
+        REQUIRE(fine.cost.max == 0.0);
+    }
+
+    SECTION("Results do not depend on the thread count") {
+        gbm.steps = 50;
+        policy.kind = HedgePolicyKind::Gamma;
+        costs.proportional = 0.001;
+        HedgeReport one = simulate_hedging(option, policy, costs, gbm, 1);
+        HedgeReport many = simulate_hedging(option, policy, costs, gbm, 5);
+        REQUIRE(one.paths.size() == many.paths.size());
+        for (std::size_t i = 0; i < one.paths.size(); ++i) {
+            REQUIRE(one.paths[i].pnl == many.paths[i].pnl);
+            REQUIRE(one.paths[i].trades == many.paths[i].trades);
+        }
+        REQUIRE(one.pnl.p05 == many.pnl.p05);
+    }
+
+    SECTION("Bands trade less than every-step hedging") {
+        gbm.steps = 100;
+        costs.proportional = 0.002;
+        costs.per_trade = 0.01;
+        HedgeReport time = simulate_hedging(option, policy, costs, gbm);
+        policy.kind = HedgePolicyKind::Band;
+        policy.band = 0.05;
+        HedgeReport band = simulate_hedging(option, policy, costs, gbm);
+        policy.kind = HedgePolicyKind::Gamma;
+        HedgeReport gamma = simulate_hedging(option, policy, costs, gbm);
+        policy.kind = HedgePolicyKind::Time;
+        policy.interval = 10;
+        HedgeReport sparse = simulate_hedging(option, policy, costs, gbm);
+
+        REQUIRE(time.trades.max == 100.0);
+        REQUIRE(sparse.trades.max == 10.0);
+        REQUIRE(band.trades.mean < 0.5 * time.trades.mean);
+        REQUIRE(gamma.trades.mean < time.trades.mean);
+        REQUIRE(band.cost.mean < time.cost.mean);
+        REQUIRE(gamma.cost.mean < time.cost.mean);
+        REQUIRE(time.cost.min > 0.0);
+        REQUIRE(band.tracking_error.mean > time.tracking_error.mean);
+    }
+
+    SECTION("One step by hand") {
+        HedgePaths paths;
+        paths.steps = 1;
+        paths.spots = {100.0, 104.0, 100.0, 93.0};
+        costs.proportional = 0.001;
+        HedgeReport report = simulate_hedging(option, policy, costs, paths, 1);
+        REQUIRE(report.paths.size() == 2);
+
+        Greeks g = calculate_all(true, 100.0, 100.0, 0.5, 0.03, 0.2, 0.01);
+        double fee = 0.001 * g.delta * 100.0;
+        for (std::size_t i = 0; i < 2; ++i) {
+            double S1 = paths.path(i)[1];
+            double cash = (g.price - g.delta * 100.0 - fee) * std::exp(0.03 * 0.5) + g.delta * 100.0 * 0.01 * 0.5;
+            double expected = -std::max(S1 - 100.0, 0.0) + g.delta * S1 + cash;
+            REQUIRE(std::abs(report.paths[i].pnl - expected) < 1e-9);
+            REQUIRE(std::abs(report.paths[i].cost - fee) < 1e-12);
+            REQUIRE(report.paths[i].trades == 1);
+            REQUIRE(std::abs(report.paths[i].tracking_error - std::abs(expected + fee)) < 1e-9);
+        }
+    }
+
+    SECTION("The Whalley-Wilmott band scales with the position gamma") {
+        HedgePaths paths;
+        paths.steps = 1;
+        paths.spots = {100.0, 100.0};
+        costs.proportional = 0.001;
+        policy.kind = HedgePolicyKind::Gamma;
+        Greeks g = calculate_all(true, 100.0, 100.0, 0.5, 0.03, 0.2, 0.01);
+        for (double quantity : {-1.0, -8.0}) {
+            option.quantity = quantity;
+            HedgeReport report = simulate_hedging(option, policy, costs, paths, 1);
+            // The first rehedge goes from no shares to the near edge of the band.
+            double position_gamma = -quantity * g.gamma;
+            double half = std::cbrt(1.5 * std::exp(-0.03 * 0.5) * 0.001 * 100.0 * position_gamma * position_gamma);
+            double fee = 0.001 * (-quantity * g.delta - half) * 100.0;
+            REQUIRE(report.paths[0].trades == 1);
+            REQUIRE(std::abs(report.paths[0].cost - fee) < 1e-12);
+        }
+    }
+
+    SECTION("Paths from a file") {
+        std::string path = "/tmp/oqg_hedge_" + std::to_string(::getpid()) + ".csv";
+        {
+            std::ofstream out(path);
+            out << "# spot paths\n100,101,99.5,102\n\n100,98,97,96.5\n";
+        }
+        HedgePaths paths = read_hedge_paths(path);
+        REQUIRE(paths.steps == 3);
+        REQUIRE(paths.count() == 2);
+        REQUIRE(paths.path(1)[3] == 96.5);
+        option.call = false;
+        policy.kind = HedgePolicyKind::Band;
+        HedgeReport report = simulate_hedging(option, policy, costs, paths);
+        REQUIRE(report.path_steps == 6);
+        REQUIRE(std::isfinite(report.pnl.mean));
+
+        {
+            std::ofstream out(path);
+            out << "100,101,99.5\n100,98\n";
+        }
+        REQUIRE_THROWS_AS(read_hedge_paths(path), std::runtime_error);
+        std::remove(path.c_str());
+        REQUIRE_THROWS_AS(read_hedge_paths(path), std::runtime_error);
+    }
+
+    SECTION("Invalid setups throw") {
+        policy.interval = 0;
+        REQUIRE_THROWS_AS(simulate_hedging(option, policy, costs, gbm), std::invalid_argument);
+        policy.interval = 1;
+        gbm.steps = 0;
+        REQUIRE_THROWS_AS(simulate_hedging(option, policy, costs, gbm), std::invalid_argument);
+        HedgePaths paths;
+        paths.steps = 1;
+        paths.spots = {100.0, -1.0};
+        REQUIRE_THROWS_AS(simulate_hedging(option, policy, costs, paths), std::invalid_argument);
+    }
+
+    SECTION("Distribution summary") {
+        HedgeDistribution d = hedge_distribution({4.0, 1.0, 3.0, 2.0, 5.0});
+        REQUIRE(d.mean == 3.0);
+        REQUIRE(d.p50 == 3.0);
+        REQUIRE(d.min == 1.0);
+        REQUIRE(d.max == 5.0);
+        REQUIRE(std::abs(d.p95 - 4.8) < 1e-12);
+        REQUIRE(std::abs(d.std_dev - std::sqrt(2.5)) < 1e-12);
+    }
+}
@@ -0,0 +1,186 @@
+#include <catch2/catch_all.hpp>
+#include "models/heston.h"
+#include "math/fft.h"
+#include "Greeks.h"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Radix-2 FFT", "[heston]") {
+    std::vector<std::complex<double>> x(64);
+    for (std::size_t j = 0; j < x.size(); ++j) {
+        x[j] = {std::sin(0.3 * j) + 0.1 * j, std::cos(1.7 * j)};
+    }
+    std::vector<std::complex<double>> X = x;
+    fft(X);
+    for (std::size_t k = 0; k < x.size(); k += 5) {
+        std::complex<double> direct = 0.0;
+        for (std::size_t j = 0; j < x.size(); ++j) {
+            direct += x[j] * std::polar(1.0, -2.0 * M_PI * static_cast<double>(j * k) / x.size());
+        }
+        REQUIRE(std::abs(X[k] - direct) < 1e-10);
+    }
+    std::vector<std::complex<double>> odd(48);
+    REQUIRE_THROWS_AS(fft(odd), std::invalid_argument);
+}
+
+TEST_CASE("Heston FFT chains", "[heston]") {
+    SECTION("Reference price") {
+        // Parameters from the "little Heston trap" tests; the call is 5.785155450.
+        HestonEngine engine({0.0175, 1.5768, 0.0398, 0.5751, -0.5711}, 0.0, 0.0);
+        double K = 100.0;
+        Greeks g;
+        REQUIRE(engine.price_chain(100.0, 1.0, &K, nullptr, 1, &g) == 0);
+        REQUIRE(std::abs(g.price - 5.785155450) < 1e-6);
+    }
+
+    SECTION("Vanishing vol of variance recovers Black-Scholes-Merton") {
+        HestonEngine engine({0.04, 1.0, 0.04, 1e-4, 0.0}, 0.03, 0.01);
+        std::vector<double> K = {80.0, 95.0, 100.0, 110.0, 130.0};
+        for (std::uint8_t call : {0, 1}) {
+            std::vector<std::uint8_t> flags(K.size(), call);
+            std::vector<Greeks> g(K.size());
+            REQUIRE(engine.price_chain(100.0, 0.5, K.data(), flags.data(), K.size(), g.data()) == 0);
+            for (std::size_t i = 0; i < K.size(); ++i) {
+                Greeks ref = calculate_all(call, 100.0, K[i], 0.5, 0.03, 0.2, 0.01);
+                REQUIRE(std::abs(g[i].price - ref.price) < 1e-5);
+                REQUIRE(std::abs(g[i].delta - ref.delta) < 1e-6);
+                REQUIRE(std::abs(g[i].gamma - ref.gamma) < 1e-6);
+                REQUIRE(std::abs(g[i].theta - ref.theta) < 1e-6);
+                REQUIRE(std::abs(g[i].rho - ref.rho) < 1e-6);
+                REQUIRE(std::abs(g[i].epsilon - ref.epsilon) < 1e-6);
+                REQUIRE(std::abs(g[i].charm - ref.charm) < 1e-6);
+                REQUIRE(std::abs(g[i].speed - ref.speed) < 1e-7);
+            }
+        }
+    }
+
+    HestonParams p{0.03, 1.2, 0.05, 0.6, -0.6};
+    const double S = 100.0, T = 0.7, r = 0.03, q = 0.01, h = 1e-4;
+    auto price = [&](HestonParams params, double TT, double rr, double qq, bool call, double K) {
+        HestonEngine engine(params, rr, qq);
+        Greeks g;
+        std::uint8_t c = call;
+        engine.price_chain(S, TT, &K, &c, 1, &g, kHestonColumns, ScalingParams::no_scaling());
+        return g;
+    };
+
+    SECTION("Greeks from the characteristic function match finite differences") {
+        for (bool call : {true, false}) {
+            for (double K : {85.0, 105.0}) {
+                Greeks g = price(p, T, r, q, call, K);
+                Greeks tu = price(p, T + h, r, q, call, K), td = price(p, T - h, r, q, call, K);
+                Greeks ru = price(p, T, r + h, q, call, K), rd = price(p, T, r - h, q, call, K);
+                Greeks qu = price(p, T, r, q + h, call, K), qd = price(p, T, r, q - h, call, K);
+                HestonParams up = p, down = p;
+                up.v0 = std::pow(std::sqrt(p.v0) + h, 2);
+                down.v0 = std::pow(std::sqrt(p.v0) - h, 2);
+                Greeks vu = price(up, T, r, q, call, K), vd = price(down, T, r, q, call, K);
+
+                auto close = [](double analytic, double fd, double tol) {
+                    return std::abs(analytic - fd) < tol * std::max(1.0, std::abs(fd));
+                };
+                REQUIRE(close(g.theta, -(tu.price - td.price) / (2 * h), 1e-6));
+                REQUIRE(close(g.charm, -(tu.delta - td.delta) / (2 * h), 1e-6));
+                REQUIRE(close(g.color, -(tu.gamma - td.gamma) / (2 * h), 1e-6));
+                REQUIRE(close(g.veta, -(tu.vega - td.vega) / (2 * h), 1e-6));
+                REQUIRE(close(g.rho, (ru.price - rd.price) / (2 * h), 1e-6));
+                REQUIRE(close(g.vera, (ru.vega - rd.vega) / (2 * h), 1e-6));
+                REQUIRE(close(g.epsilon, (qu.price - qd.price) / (2 * h), 1e-6));
+                REQUIRE(close(g.vega, (vu.price - vd.price) / (2 * h), 1e-6));
+                REQUIRE(close(g.volga, (vu.vega - vd.vega) / (2 * h), 1e-6));
+                REQUIRE(close(g.ultima, (vu.volga - vd.volga) / (2 * h), 1e-6));
+                REQUIRE(close(g.vanna, (vu.delta - vd.delta) / (2 * h), 1e-6));
+                REQUIRE(close(g.zomma, (vu.gamma - vd.gamma) / (2 * h), 1e-6));
+                REQUIRE(close(g.dvanna_dvol, (vu.vanna - vd.vanna) / (2 * h), 1e-6));
+                REQUIRE(std::abs(g.lambda - g.delta * S / g.price) < 1e-12);
+                REQUIRE(std::isnan(g.dual_rho));
+            }
+        }
+    }
+
+    SECTION("Put-call parity and chains across expiries") {
+        HestonEngine engine(p, r, q);
+        std::vector<HestonChain> chains(4);
+        for (std::size_t e = 0; e < chains.size(); ++e) {
+            chains[e].T = 0.25 * (e + 1);
+            for (double K = 60.0; K <= 140.0; K += 5.0) {
+                chains[e].strikes.push_back(K);
+                chains[e].call.push_back(static_cast<std::uint8_t>(chains[e].strikes.size() % 2));
+            }
+        }
+        chains[1].strikes[3] = -5.0;
+        REQUIRE(engine.price_chains(S, chains, kHestonColumns, ScalingParams::standard(), 3) == 1);
+        REQUIRE(engine.cached_expiries() == 4);
+        REQUIRE(std::isnan(chains[1].greeks[3].price));
+
+        for (const HestonChain& chain : chains) {
+            std::vector<std::uint8_t> flipped(chain.call.size());
+            for (std::size_t i = 0; i < flipped.size(); ++i) {
+                flipped[i] = !chain.call[i];
+            }
+            std::vector<Greeks> other(chain.strikes.size());
+            engine.price_chain(S, chain.T, chain.strikes.data(), flipped.data(), flipped.size(), other.data());
+            for (std::size_t i = 0; i < chain.strikes.size(); ++i) {
+                if (!(chain.strikes[i] > 0.0)) {
+                    continue;
+                }
+                const Greeks& c = chain.call[i] ? chain.greeks[i] : other[i];
+                const Greeks& pt = chain.call[i] ? other[i] : chain.greeks[i];
+                double forward = S * std::exp(-q * chain.T) - chain.strikes[i] * std::exp(-r * chain.T);
+                REQUIRE(std::abs(c.price - pt.price - forward) < 1e-9);
+                REQUIRE(std::abs(c.delta - pt.delta - std::exp(-q * chain.T)) < 1e-12);
+                REQUIRE(c.gamma == pt.gamma);
+                REQUIRE(c.vega == pt.vega);
+                REQUIRE(c.price > 0.0);
+                REQUIRE(pt.price > 0.0);
+            }
+        }
+        // Same expiries at another spot reuse the cached transforms.
+        Greeks moved;
+        double K = 100.0;
+        engine.price_chain(101.0, 0.5, &K, nullptr, 1, &moved);
+        REQUIRE(engine.cached_expiries() == 4);
+        REQUIRE(std::abs(moved.price - price(p, 0.5, r, q, true, 100.0 / 101.0 * 100.0).price * 1.01) < 1e-9);
+        engine.clear_cache();
+        REQUIRE(engine.cached_expiries() == 0);
+    }
+
+    SECTION("The expiry cache is bounded") {
+        HestonFftOptions options;
+        options.points = 1024;
+        options.cached_expiries = 3;
+        HestonEngine engine(p, r, q, options);
+        double K = 100.0;
+        Greeks first, again;
+        // A live marking loop ages T on every call, so each call is a new expiry.
+        for (int n = 0; n < 10; ++n) {
+            Greeks g;
+            engine.price_chain(S, 0.5 - n / 3650.0, &K, nullptr, 1, &g, greek_bit(GreekColumn::Price));
+            if (n == 9) {
+                first = g;
+            }
+            REQUIRE(engine.cached_expiries() == static_cast<std::size_t>(std::min(n + 1, 3)));
+        }
+        engine.price_chain(S, 0.5 - 9 / 3650.0, &K, nullptr, 1, &again, greek_bit(GreekColumn::Price));
+        REQUIRE(again.price == first.price);
+        REQUIRE(engine.cached_expiries() == 3);
+        options.cached_expiries = 0;
+        REQUIRE_THROWS_AS(HestonEngine(p, r, q, options), std::invalid_argument);
+    }
+
+    SECTION("Invalid inputs") {
+        REQUIRE_THROWS_AS(HestonEngine({0.04, 1.0, 0.04, 0.5, 1.0}, 0.0), std::invalid_argument);
+        REQUIRE_THROWS_AS(HestonEngine(p, 0.0, 0.0, {1000, 0.25, 1.5}), std::invalid_argument);
+        HestonEngine engine(p, r, q);
+        double K[] = {100.0, 1e9};
+        Greeks g[2];
+        REQUIRE(engine.price_chain(S, 0.0, K, nullptr, 2, g) == 2);
+        REQUIRE(engine.price_chain(S, 1.0, K, nullptr, 2, g) == 1);
+        REQUIRE(std::isnan(g[1].price));
+    }
+}
@@ -0,0 +1,204 @@
+#include <catch2/catch_all.hpp>
+#include "models/models.h"
+#include "capi/greeks_c.h"
+#include "Greeks.h"
+#include <cmath>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+namespace {
+    struct Point {
+        double F, K, T, r, sigma;
+    };
+
+    enum class Arg { F, T, R, Sigma };
+
+    // Central difference of one column in one argument, with the library's unscaled convention.
+    template <typename Model>
+    double difference(GreekColumn column, bool call, Point p, Arg arg, double h) {
+        auto eval = [&](double offset) {
+            Point x = p;
+            double& a = arg == Arg::F ? x.F : arg == Arg::T ? x.T : arg == Arg::R ? x.r : x.sigma;
+            a += offset;
+            Greeks g = model_greeks<Model>(call, x.F, x.K, x.T, x.r, x.sigma, ScalingParams::no_scaling());
+            return greek_field(g, column);
+        };
+        return (eval(-2.0 * h) - 8.0 * eval(-h) + 8.0 * eval(h) - eval(2.0 * h)) / (12.0 * h);
+    }
+
+    template <typename Model>
+    void check_derivatives(const std::vector<Point>& points, double dF) {
+        struct Check {
+            GreekColumn child, parent;
+            Arg arg;
+            double sign;
+        };
+        const Check checks[] = {
+            {GreekColumn::Delta, GreekColumn::Price, Arg::F, 1.0},     {GreekColumn::Vega, GreekColumn::Price, Arg::Sigma, 1.0},
+            {GreekColumn::Theta, GreekColumn::Price, Arg::T, -1.0},    {GreekColumn::Rho, GreekColumn::Price, Arg::R, 1.0},
+            {GreekColumn::Gamma, GreekColumn::Delta, Arg::F, 1.0},     {GreekColumn::Vanna, GreekColumn::Delta, Arg::Sigma, 1.0},
+            {GreekColumn::Charm, GreekColumn::Delta, Arg::T, -1.0},    {GreekColumn::Volga, GreekColumn::Vega, Arg::Sigma, 1.0},
+            {GreekColumn::Veta, GreekColumn::Vega, Arg::T, -1.0},      {GreekColumn::Vera, GreekColumn::Rho, Arg::Sigma, 1.0},
+            {GreekColumn::Speed, GreekColumn::Gamma, Arg::F, 1.0},     {GreekColumn::Zomma, GreekColumn::Gamma, Arg::Sigma, 1.0},
+            {GreekColumn::Color, GreekColumn::Gamma, Arg::T, -1.0},    {GreekColumn::Ultima, GreekColumn::Volga, Arg::Sigma, 1.0},
+            {GreekColumn::DvannaDvol, GreekColumn::Vanna, Arg::Sigma, 1.0}, {GreekColumn::Snap, GreekColumn::Speed, Arg::F, 1.0},
+            {GreekColumn::Jounce, GreekColumn::Snap, Arg::F, 1.0},     {GreekColumn::Pounce, GreekColumn::Jounce, Arg::F, 1.0},
+        };
+        for (const Point& p : points) {
+            for (bool call : {true, false}) {
+                Greeks g = model_greeks<Model>(call, p.F, p.K, p.T, p.r, p.sigma, ScalingParams::no_scaling());
+                for (const Check& c : checks) {
+                    double h = c.arg == Arg::F ? dF : c.arg == Arg::T ? 1e-4 * p.T : c.arg == Arg::R ? 1e-4 : 1e-4 * p.sigma;
+                    double fd = c.sign * difference<Model>(c.parent, call, p, c.arg, h);
+                    double value = greek_field(g, c.child);
+                    INFO(greek_name(c.child) << " call=" << call << " F=" << p.F << " K=" << p.K << " T=" << p.T);
+                    REQUIRE(std::abs(value - fd) < 1e-5 * (1.0 + std::abs(fd)));
+                }
+                REQUIRE(std::isnan(g.epsilon));
+                REQUIRE(std::isnan(g.crackle));
+            }
+        }
+    }
+}
+
+TEST_CASE("Black-76 Model", "[models]") {
+    std::vector<Point> points = {{100.0, 100.0, 0.5, 0.03, 0.25}, {100.0, 80.0, 1.0, 0.05, 0.3}, {50.0, 60.0, 2.0, 0.01, 0.4}};
+
+    SECTION("Matches BSM on the forward with q = r") {
+        for (const Point& p : points) {
+            for (bool call : {true, false}) {
+                Greeks g = model_greeks<Black76Model>(call, p.F, p.K, p.T, p.r, p.sigma);
+                double tol = 1e-12 * p.F;
+                REQUIRE(std::abs(g.price - calculate_price(call, p.F, p.K, p.T, p.r, p.sigma, p.r)) < tol);
+                REQUIRE(std::abs(g.delta - calculate_delta(call, p.F, p.K, p.T, p.r, p.sigma, p.r)) < 1e-14);
+                REQUIRE(std::abs(g.gamma - calculate_gamma(p.F, p.K, p.T, p.r, p.sigma, p.r)) < 1e-14);
+                REQUIRE(std::abs(g.vega - calculate_vega(p.F, p.K, p.T, p.r, p.sigma, p.r)) < tol);
+                REQUIRE(std::abs(g.theta - calculate_theta(call, p.F, p.K, p.T, p.r, p.sigma, p.r)) < tol);
+                REQUIRE(std::abs(g.rho + p.T * g.price / 100.0) < tol);
+            }
+        }
+    }
+
+    SECTION("Greeks are derivatives of one another") {
+        check_derivatives<Black76Model>(points, 1e-3);
+    }
+
+    SECTION("Implied volatility round trip") {
+        for (const Point& p : points) {
+            for (double sigma : {0.05, 0.25, 1.5}) {
+                for (bool call : {true, false}) {
+                    double price = Black76Model::price(call, p.F, p.K, p.T, p.r, sigma);
+                    REQUIRE(std::abs(Black76Model::implied_volatility(call, p.F, p.K, p.T, p.r, price) - sigma) < 1e-10);
+                }
+            }
+        }
+        REQUIRE(std::isnan(Black76Model::implied_volatility(true, 100.0, 100.0, 1.0, 0.0, 100.0)));
+        REQUIRE(std::isnan(Black76Model::implied_volatility(true, 120.0, 100.0, 1.0, 0.0, 19.0)));
+        REQUIRE_THROWS_AS(model_greeks<Black76Model>(true, -1.0, 100.0, 1.0, 0.0, 0.2), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Bachelier Model", "[models]") {
+    // Rates-style inputs: forwards and strikes around zero, absolute volatilities.
+    std::vector<Point> points = {{0.02, 0.02, 1.0, 0.03, 0.008}, {-0.005, 0.01, 2.0, 0.01, 0.01}, {0.03, 0.015, 0.25, 0.0, 0.006}};
+
+    SECTION("Greeks are derivatives of one another") {
+        check_derivatives<BachelierModel>(points, 1e-5);
+    }
+
+    SECTION("Put-call parity and the at-the-money price") {
+        for (const Point& p : points) {
+            double call = BachelierModel::price(true, p.F, p.K, p.T, p.r, p.sigma);
+            double put = BachelierModel::price(false, p.F, p.K, p.T, p.r, p.sigma);
+            REQUIRE(std::abs(call - put - std::exp(-p.r * p.T) * (p.F - p.K)) < 1e-16);
+        }
+        double atm = BachelierModel::price(true, 0.01, 0.01, 1.0, 0.0, 0.01);
+        REQUIRE(std::abs(atm - 0.01 / std::sqrt(2.0 * M_PI)) < 1e-16);
+    }
+
+    SECTION("Implied volatility round trip") {
+        for (const Point& p : points) {
+            for (double sigma : {0.004, 0.008, 0.05}) {
+                double call = BachelierModel::price(true, p.F, p.K, p.T, p.r, sigma);
+                double put = BachelierModel::price(false, p.F, p.K, p.T, p.r, sigma);
+                if (std::min(call, put) < 1e-8 * std::max(call, put)) {
+                    continue;    // In the money the time value is below double precision
+                }
+                REQUIRE(std::abs(BachelierModel::implied_volatility(true, p.F, p.K, p.T, p.r, call) - sigma) < 1e-8 * sigma);
+                REQUIRE(std::abs(BachelierModel::implied_volatility(false, p.F, p.K, p.T, p.r, put) - sigma) < 1e-8 * sigma);
+            }
+        }
+        // Fifteen standard deviations out of the money: solved on log price.
+        double tiny = BachelierModel::price(false, 0.03, 0.015, 1.0, 0.0, 0.001);
+        REQUIRE(tiny < 1e-50);
+        REQUIRE(std::abs(BachelierModel::implied_volatility(false, 0.03, 0.015, 1.0, 0.0, tiny) - 0.001) < 1e-12);
+        REQUIRE(std::isnan(BachelierModel::implied_volatility(true, 0.03, 0.01, 1.0, 0.0, 0.01)));
+    }
+}
+
+TEST_CASE("Model Batch Entry Points", "[models]") {
+    std::vector<std::uint8_t> call = {1, 0, 1, 1};
+    std::vector<double> F = {0.02, -0.01, 0.0, 0.01}, K = {0.02, 0.0, 0.01, 0.01}, T = {1.0, 0.5, 2.0, -1.0};
+    std::vector<double> sigma = {0.01, 0.008, 0.012, 0.01};
+    double r = 0.02;
+    std::vector<double> price(4), vega(4), gamma(4), iv(4);
+    std::vector<std::int32_t> status(4), iv_status(4);
+
+    BatchInputs in;
+    in.count = 4;
+    in.call = {call.data()};
+    in.S = {F.data()};
+    in.K = {K.data()};
+    in.T = {T.data()};
+    in.r = {&r, 0};
+    in.sigma = {sigma.data()};
+    BatchOutputs out;
+    out.columns = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Vega) | greek_bit(GreekColumn::Gamma);
+    out.greeks[static_cast<int>(GreekColumn::Price)] = {price.data()};
+    out.greeks[static_cast<int>(GreekColumn::Vega)] = {vega.data()};
+    out.greeks[static_cast<int>(GreekColumn::Gamma)] = {gamma.data()};
+    out.status = {status.data()};
+
+    REQUIRE(model_batch_greeks<BachelierModel>(in, out, ScalingParams::standard(), 2) == 1);
+    for (std::size_t i = 0; i < 3; ++i) {
+        Greeks g = model_greeks<BachelierModel>(call[i] != 0, F[i], K[i], T[i], r, sigma[i]);
+        REQUIRE(status[i] == 0);
+        REQUIRE(price[i] == g.price);
+        REQUIRE(vega[i] == g.vega);
+        REQUIRE(gamma[i] == g.gamma);
+    }
+    REQUIRE(status[3] == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+    REQUIRE(std::isnan(price[3]));
+
+    REQUIRE(model_batch_implied_volatility<BachelierModel>(in, {price.data()}, {iv.data()}, {iv_status.data()}) == 1);
+    for (std::size_t i = 0; i < 3; ++i) {
+        REQUIRE(std::abs(iv[i] - sigma[i]) < 1e-12);
+    }
+
+    SECTION("C ABI") {
+        REQUIRE(oqg_abi_version() == 2);
+        oqg_inputs cin = {};
+        cin.count = 3;
+        cin.spot = F.data();
+        cin.spot_stride = 1;
+        cin.strike = K.data();
+        cin.strike_stride = 1;
+        cin.expiry = T.data();
+        cin.expiry_stride = 1;
+        cin.rate = &r;
+        cin.vol = sigma.data();
+        cin.vol_stride = 1;
+        std::vector<double> c_price(3);
+        oqg_outputs cout = {};
+        cout.columns = OQG_COLUMN_BIT(OQG_PRICE);
+        cout.data[OQG_PRICE] = c_price.data();
+        REQUIRE(oqg_model_greeks(OQG_MODEL_BACHELIER, &cin, &cout, nullptr, 0) == OQG_OK);
+        REQUIRE(c_price[0] == BachelierModel::price(true, F[0], K[0], T[0], r, sigma[0]));
+        REQUIRE(oqg_model_greeks(7, &cin, &cout, nullptr, 0) == OQG_ERROR_ARGUMENT);
+
+        std::vector<double> c_iv(3);
+        REQUIRE(oqg_model_implied_volatility(OQG_MODEL_BACHELIER, &cin, c_price.data(), 1, c_iv.data(), 1, nullptr, 0, 0) == OQG_OK);
+        REQUIRE(std::abs(c_iv[0] - sigma[0]) < 1e-12);
+    }
+}
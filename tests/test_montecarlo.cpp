@@ -0,0 +1,63 @@
+#include <catch2/catch_all.hpp>
+#include "mc/montecarlo.h"
+#include "Greeks.h"
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Monte Carlo Greeks", "[montecarlo]") {
+    double S = 100.0, K = 95.0, T = 0.75, r = 0.04, sigma = 0.25, q = 0.01;
+    ScalingParams scaling = ScalingParams::no_scaling();
+
+    MonteCarloParams params;
+    params.paths = 1u << 20;
+    params.seed = 42;
+
+    auto within = [](const MonteCarloEstimate& e, double expected) {
+        return std::abs(e.value - expected) < 5.0 * e.std_error + 1e-12;
+    };
+
+    SECTION("Estimators agree with closed form") {
+        for (bool call : {true, false}) {
+            MonteCarloGreeks mc = monte_carlo_greeks(call, S, K, T, r, sigma, q, params, scaling);
+            double delta = calculate_delta(call, S, K, T, r, sigma, q);
+            double gamma = calculate_gamma(S, K, T, r, sigma, q);
+            double vega = calculate_vega(S, K, T, r, sigma, q, scaling);
+            double vanna = calculate_vanna(S, K, T, r, sigma, q, scaling);
+
+            REQUIRE(within(mc.price, calculate_price(call, S, K, T, r, sigma, q)));
+            REQUIRE(within(mc.delta_pathwise, delta));
+            REQUIRE(within(mc.delta_lr, delta));
+            REQUIRE(within(mc.gamma_pathwise, gamma));
+            REQUIRE(within(mc.gamma_lr, gamma));
+            REQUIRE(within(mc.vega_pathwise, vega));
+            REQUIRE(within(mc.vega_lr, vega));
+            REQUIRE(within(mc.vanna_pathwise, vanna));
+            REQUIRE(within(mc.vanna_lr, vanna));
+        }
+    }
+
+    SECTION("Results do not depend on thread count") {
+        params.paths = 100000;
+        params.threads = 1;
+        MonteCarloGreeks single = monte_carlo_greeks(true, S, K, T, r, sigma, q, params, scaling);
+        params.threads = 7;
+        MonteCarloGreeks multi = monte_carlo_greeks(true, S, K, T, r, sigma, q, params, scaling);
+        REQUIRE(single.price.value == multi.price.value);
+        REQUIRE(single.gamma_lr.value == multi.gamma_lr.value);
+        REQUIRE(single.vanna_pathwise.std_error == multi.vanna_pathwise.std_error);
+    }
+
+    SECTION("Control variate reduces price error") {
+        params.control_variate = false;
+        MonteCarloGreeks plain = monte_carlo_greeks(true, S, K, T, r, sigma, q, params, scaling);
+        params.control_variate = true;
+        MonteCarloGreeks controlled = monte_carlo_greeks(true, S, K, T, r, sigma, q, params, scaling);
+        REQUIRE(controlled.price.std_error < plain.price.std_error);
+    }
+
+    SECTION("Invalid inputs") {
+        params.paths = 1;
+        REQUIRE_THROWS_AS(monte_carlo_greeks(true, S, K, T, r, sigma, q, params), std::invalid_argument);
+        REQUIRE_THROWS_AS(monte_carlo_greeks(true, S, K, -1.0, r, sigma, q), std::invalid_argument);
+    }
+}
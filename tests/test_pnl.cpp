@@ -0,0 +1,158 @@
+#include <catch2/catch_all.hpp>
+#include "pnl/explain.h"
+#include "Greeks.h"
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+namespace {
+    constexpr double kDay = 86400.0;
+    constexpr double kYear = 365.0 * kDay;
+
+    std::vector<PnlPosition> book() {
+        return {
+            {"SPX-C-100", "SPX", true, 100.0, 0.5 * kYear, 0.03, 0.01, 10.0},
+            {"SPX-P-90", "SPX", false, 90.0, 0.25 * kYear, 0.03, 0.01, -5.0},
+            {"NDX-C-110", "NDX", true, 110.0, 1.0 * kYear, 0.03, 0.0, 2.0},
+        };
+    }
+
+    // A random walk in spot and volatility, one tick per contract per minute.
+    std::vector<PnlTick> history(std::size_t steps) {
+        std::vector<PnlTick> ticks;
+        double S[2] = {100.0, 105.0}, sigma[3] = {0.2, 0.25, 0.3};
+        unsigned state = 12345;
+        auto noise = [&]() {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) / double(1u << 24) - 0.5;
+        };
+        for (std::size_t i = 0; i < steps; ++i) {
+            double t = 60.0 * static_cast<double>(i);
+            S[0] *= 1.0 + 0.002 * noise();
+            S[1] *= 1.0 + 0.002 * noise();
+            for (std::uint32_t p = 0; p < 3; ++p) {
+                sigma[p] += 0.001 * noise();
+                ticks.push_back({t, p, p == 2 ? S[1] : S[0], sigma[p]});
+            }
+        }
+        return ticks;
+    }
+}
+
+TEST_CASE("P&L Explain", "[pnl]") {
+    SECTION("Buckets add up to the change in value") {
+        std::vector<PnlTick> ticks = history(500);
+        PnlExplainer explainer(book());
+        explainer.process(ticks.data(), ticks.size());
+        REQUIRE(explainer.counts().ticks == ticks.size());
+
+        for (std::size_t p = 0; p < 3; ++p) {
+            const PnlPosition& pos = explainer.positions()[p];
+            const PnlTick& first = ticks[p];
+            const PnlTick& last = ticks[ticks.size() - 3 + p];
+            double v0 = calculate_price(pos.call, first.S, pos.K, (pos.expiry - first.timestamp) / kYear, pos.r, first.sigma, pos.q);
+            double v1 = calculate_price(pos.call, last.S, pos.K, (pos.expiry - last.timestamp) / kYear, pos.r, last.sigma, pos.q);
+            PnlAttribution a = explainer.position(p);
+            REQUIRE(a.intervals == 499);
+            REQUIRE(std::abs(a.total() - pos.quantity * (v1 - v0)) < 1e-9 * std::abs(pos.quantity));
+            // Minute steps leave only third-order terms unexplained.
+            REQUIRE(std::abs(a.residual) < 1e-3 * (std::abs(a.delta) + std::abs(a.vega)));
+        }
+    }
+
+    SECTION("Pure time decay lands in theta") {
+        PnlExplainer explainer({{"C", "U", true, 100.0, 0.5 * kYear, 0.05, 0.03, 1.0}, {"P", "U", false, 100.0, 0.5 * kYear, 0.05, 0.03, 1.0}});
+        std::vector<PnlTick> ticks;
+        for (int hour = 0; hour < 30 * 24; ++hour) {
+            ticks.push_back({hour * 3600.0, 0, 100.0, 0.2});
+            ticks.push_back({hour * 3600.0, 1, 100.0, 0.2});
+        }
+        explainer.process(ticks.data(), ticks.size());
+        for (std::size_t p = 0; p < 2; ++p) {
+            PnlAttribution a = explainer.position(p);
+            REQUIRE(a.delta == 0.0);
+            REQUIRE(a.vega == 0.0);
+            REQUIRE(std::abs(a.residual) < 1e-4 * std::abs(a.theta));
+        }
+    }
+
+    SECTION("Aggregation by underlying") {
+        std::vector<PnlTick> ticks = history(50);
+        PnlExplainer explainer(book());
+        explainer.process(ticks.data(), ticks.size());
+        auto rows = explainer.by_underlying();
+        REQUIRE(rows.size() == 2);
+        REQUIRE(rows[0].first == "NDX");
+        REQUIRE(rows[1].first == "SPX");
+        REQUIRE(rows[0].second.total() == explainer.position(2).total());
+        REQUIRE(std::abs(rows[1].second.total() - explainer.position(0).total() - explainer.position(1).total()) < 1e-12);
+        REQUIRE(std::abs(explainer.total().total() - rows[0].second.total() - rows[1].second.total()) < 1e-12);
+    }
+
+    SECTION("Chunking and thread count do not change the result") {
+        std::vector<PnlTick> ticks = history(300);
+        PnlExplainer whole(book());
+        whole.process(ticks.data(), ticks.size());
+
+        PnlExplainOptions options;
+        options.threads = 1;
+        PnlExplainer pieces(book(), options);
+        for (std::size_t i = 0; i < ticks.size(); i += 7) {
+            pieces.process(ticks.data() + i, std::min<std::size_t>(7, ticks.size() - i));
+        }
+        for (std::size_t p = 0; p < 3; ++p) {
+            REQUIRE(whole.position(p).delta == pieces.position(p).delta);
+            REQUIRE(whole.position(p).residual == pieces.position(p).residual);
+        }
+    }
+
+    SECTION("Rejects bad and out-of-order ticks") {
+        PnlExplainer explainer(book());
+        std::vector<PnlTick> ticks = {
+            {0.0, 0, 100.0, 0.2}, {60.0, 0, -1.0, 0.2}, {120.0, 0, 101.0, 0.2}, {30.0, 0, 100.0, 0.2},
+            {0.6 * kYear, 0, 101.0, 0.2}, {0.0, 7, 100.0, 0.2},
+        };
+        explainer.process(ticks.data(), ticks.size());
+        REQUIRE(explainer.counts().ticks == 2);
+        REQUIRE(explainer.counts().rejected == 3);
+        REQUIRE(explainer.counts().unknown == 1);
+        REQUIRE(explainer.position(0).intervals == 1);
+        REQUIRE_THROWS_AS(PnlExplainer({book()[0], book()[0]}), std::invalid_argument);
+    }
+
+    SECTION("Streams a tick file") {
+        std::vector<PnlTick> ticks = history(200);
+        std::string path = "pnl_ticks_test.csv";
+        {
+            std::ofstream out(path);
+            out << "# timestamp,contract,S,implied_vol\n";
+            out.precision(17);
+            for (const PnlTick& t : ticks) {
+                out << t.timestamp << "," << book()[t.position].name << "," << t.S << "," << t.sigma << "\r\n";
+            }
+            out << "60,UNKNOWN,100,0.2\n";
+            out << "garbage line\n";
+            out << "\n";
+        }
+        PnlExplainer direct(book());
+        direct.process(ticks.data(), ticks.size());
+
+        PnlExplainOptions options;
+        options.chunk_ticks = 64;
+        PnlExplainer streamed(book(), options);
+        streamed.process_file(path);
+        std::remove(path.c_str());
+
+        REQUIRE(streamed.counts().ticks == ticks.size());
+        REQUIRE(streamed.counts().unknown == 1);
+        REQUIRE(streamed.counts().malformed == 1);
+        for (std::size_t p = 0; p < 3; ++p) {
+            REQUIRE(streamed.position(p).total() == direct.position(p).total());
+        }
+        REQUIRE_THROWS_AS(streamed.process_file("does_not_exist.csv"), std::runtime_error);
+    }
+}
@@ -0,0 +1,137 @@
+#include <catch2/catch_all.hpp>
+#include "batch/progressive.h"
+#include "Greeks.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+namespace {
+    bool same(double a, double b) {
+        return a == b || (std::isnan(a) && std::isnan(b));
+    }
+}
+
+TEST_CASE("Progressive Greek evaluation", "[progressive]") {
+    const std::size_t n = 4000;
+    std::vector<double> S(n), K(n), T(n), sigma(n);
+    std::vector<std::uint8_t> call(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        S[i] = 80.0 + 0.01 * i;
+        K[i] = 100.0;
+        T[i] = 0.1 + 0.0005 * i;
+        sigma[i] = 0.15 + 0.00005 * i;
+        call[i] = i % 2;
+    }
+    S[7] = -1.0;
+    double r = 0.03, q = 0.01;
+
+    BatchInputs in;
+    in.count = n;
+    in.call = {call.data(), 1};
+    in.S = {S.data(), 1};
+    in.K = {K.data(), 1};
+    in.T = {T.data(), 1};
+    in.r = {&r, 0};
+    in.sigma = {sigma.data(), 1};
+    in.q = {&q, 0};
+
+    const double sentinel = 12345.0;
+    std::vector<double> values(n * kGreekColumnCount, sentinel);
+    std::vector<std::int32_t> status(n, -1);
+    std::vector<TierMask> tiers(n, 0xff);
+    BatchOutputs out;
+    out.columns = kAllGreeks;
+    for (int c = 0; c < kGreekColumnCount; ++c) {
+        out.greeks[c] = {values.data() + c, kGreekColumnCount};
+    }
+    out.status = {status.data(), 1};
+
+    ProgressiveGreeks engine(ScalingParams::standard(), 2);
+    using Clock = ProgressiveGreeks::Clock;
+
+    REQUIRE(tier_columns(GreekTier::First) == (greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) |
+                                               greek_bit(GreekColumn::Vega) | greek_bit(GreekColumn::Theta) |
+                                               greek_bit(GreekColumn::Rho) | greek_bit(GreekColumn::Lambda) |
+                                               greek_bit(GreekColumn::Epsilon)));
+    GreekMask union_of_tiers = 0;
+    for (int t = 0; t < kGreekTierCount; ++t) {
+        REQUIRE((union_of_tiers & tier_columns(static_cast<GreekTier>(t))) == 0);
+        union_of_tiers |= tier_columns(static_cast<GreekTier>(t));
+    }
+    REQUIRE(union_of_tiers == kAllGreeks);
+
+    SECTION("A generous deadline yields every tier") {
+        ProgressiveResult res = engine.evaluate(in, out, {tiers.data(), 1}, Clock::now() + std::chrono::seconds(60));
+        REQUIRE(!res.deadline_reached);
+        REQUIRE(res.complete == kAllTiers);
+        REQUIRE(res.failures == 1);
+        for (std::size_t i = 0; i < n; i += 37) {
+            REQUIRE(tiers[i] == kAllTiers);
+            if (i == 7) {
+                continue;
+            }
+            Greeks g = calculate_all(call[i], S[i], K[i], T[i], r, sigma[i], q);
+            REQUIRE(status[i] == 0);
+            for (int c = 0; c < kGreekColumnCount; ++c) {
+                REQUIRE(same(values[i * kGreekColumnCount + c], greek_field(g, static_cast<GreekColumn>(c))));
+            }
+        }
+        REQUIRE(status[7] == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+        REQUIRE(std::isnan(values[7 * kGreekColumnCount]));
+        for (int t = 0; t < kGreekTierCount; ++t) {
+            REQUIRE(engine.timing(static_cast<GreekTier>(t)).rows == n);
+            REQUIRE(engine.timing(static_cast<GreekTier>(t)).ns_per_row > 0.0);
+        }
+    }
+
+    SECTION("Only requested tiers are evaluated") {
+        out.columns = greek_bit(GreekColumn::Delta) | greek_bit(GreekColumn::Gamma);
+        ProgressiveResult res = engine.evaluate(in, out, {tiers.data(), 1}, Clock::now() + std::chrono::seconds(60));
+        REQUIRE(res.complete == (tier_bit(GreekTier::First) | tier_bit(GreekTier::Second)));
+        REQUIRE(values[0] == sentinel);
+        REQUIRE(values[static_cast<int>(GreekColumn::Delta)] == calculate_delta(false, S[0], K[0], T[0], r, sigma[0], q));
+        REQUIRE(engine.timing(GreekTier::Third).rows == 0);
+    }
+
+    SECTION("A passed deadline computes nothing but still reports status") {
+        ProgressiveResult res = engine.evaluate(in, out, {tiers.data(), 1}, Clock::now() - std::chrono::milliseconds(1));
+        REQUIRE(res.deadline_reached);
+        REQUIRE(res.complete == 0);
+        REQUIRE(res.rows[0] == 0);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(tiers[i] == 0);
+            REQUIRE(status[i] == (i == 7 ? 1 : 0));
+        }
+        REQUIRE(values[0] == sentinel);
+        REQUIRE(engine.timing(GreekTier::Sixth).deferred == n);
+    }
+
+    SECTION("A tight deadline keeps tiers in priority order") {
+        // Warm the timings, then leave time for a fraction of the work.
+        engine.evaluate(in, out, {tiers.data(), 1}, Clock::now() + std::chrono::seconds(60));
+        std::fill(values.begin(), values.end(), sentinel);
+        ProgressiveResult res = engine.evaluate(in, out, {tiers.data(), 1}, Clock::now() + std::chrono::microseconds(300));
+        REQUIRE(res.deadline_reached);
+        REQUIRE(res.complete != kAllTiers);
+        for (int t = 1; t < kGreekTierCount; ++t) {
+            REQUIRE(res.rows[t] <= res.rows[t - 1]);
+            if (res.rows[t] > 0) {
+                REQUIRE(res.rows[t - 1] == n);
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) {
+            // Present tiers form a prefix, and their columns hold exact values.
+            REQUIRE((tiers[i] & (tiers[i] + 1)) == 0);
+            if (i == 7 || !(tiers[i] & tier_bit(GreekTier::First))) {
+                continue;
+            }
+            REQUIRE(values[i * kGreekColumnCount] == calculate_price(call[i], S[i], K[i], T[i], r, sigma[i], q));
+            if (!(tiers[i] & tier_bit(GreekTier::Second))) {
+                REQUIRE(values[i * kGreekColumnCount + static_cast<int>(GreekColumn::Gamma)] == sentinel);
+            }
+        }
+    }
+}
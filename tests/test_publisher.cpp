@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+#include "publish/publisher.h"
+#include "Greeks.h"
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Publisher round trip", "[publisher]") {
+    std::vector<std::uint64_t> ids = {501, 17, 9000};
+    GreekPublisher all(ids);
+    REQUIRE(all.size() == 3);
+    REQUIRE(all.width() == static_cast<std::size_t>(kGreekColumnCount));
+    REQUIRE(all.slot(17) == 1);
+    REQUIRE(all.slot(18) == -1);
+
+    Greeks g = calculate_all(true, 100.0, 105.0, 0.5, 0.03, 0.25, 0.01);
+    Greeks out;
+    double stamp = 0.0;
+    REQUIRE(!all.read(2, out));
+    REQUIRE(all.version(2) == 0);
+    all.publish(2, g, 12.5);
+    all.publish(2, g, 13.5);
+    REQUIRE(all.version(2) == 2);
+    REQUIRE(all.read(2, out, &stamp));
+    REQUIRE(stamp == 13.5);
+    for (int c = 0; c < kGreekColumnCount; ++c) {
+        double a = greek_field(g, static_cast<GreekColumn>(c)), b = greek_field(out, static_cast<GreekColumn>(c));
+        REQUIRE((a == b || (std::isnan(a) && std::isnan(b))));
+    }
+
+    SECTION("Selected columns only") {
+        GreekMask core = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) | greek_bit(GreekColumn::Gamma);
+        GreekPublisher few(ids, core);
+        REQUIRE(few.width() == 3);
+        few.publish(0, g, 1.0);
+        Greeks partial;
+        REQUIRE(few.read(0, partial));
+        REQUIRE(partial.price == g.price);
+        REQUIRE(partial.gamma == g.gamma);
+        REQUIRE(std::isnan(partial.vega));
+
+        double packed[3] = {1.0, 2.0, 3.0}, back[3] = {};
+        few.publish(1, packed, 2.0);
+        REQUIRE(few.read(1, back));
+        REQUIRE(back[2] == 3.0);
+    }
+
+    REQUIRE_THROWS_AS(GreekPublisher({1, 2, 1}), std::invalid_argument);
+    REQUIRE_THROWS_AS(GreekPublisher(ids, 0), std::invalid_argument);
+}
+
+TEST_CASE("Readers never see torn publications", "[publisher]") {
+    // Every publication writes the same value to all columns, so a torn read shows up
+    // as a slot whose columns disagree.
+    const std::size_t slots = 4;
+    GreekPublisher board({0, 1, 2, 3});
+    std::atomic<bool> done{false};
+    std::atomic<std::uint64_t> torn{0}, backwards{0}, reads{0};
+
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 4; ++t) {
+        readers.emplace_back([&, t] {
+            double values[kGreekColumnCount];
+            double last[slots] = {};
+            std::size_t s = static_cast<std::size_t>(t);
+            while (!done.load(std::memory_order_relaxed)) {
+                s = (s + 1) % slots;
+                double stamp;
+                if (!board.read(s, values, &stamp)) {
+                    continue;
+                }
+                for (int c = 0; c < kGreekColumnCount; ++c) {
+                    torn += values[c] != stamp;
+                }
+                backwards += stamp < last[s];
+                last[s] = stamp;
+                ++reads;
+            }
+        });
+    }
+
+    double values[kGreekColumnCount];
+    for (int i = 1; i <= 200000; ++i) {
+        for (double& v : values) {
+            v = i;
+        }
+        board.publish(static_cast<std::size_t>(i) % slots, values, i);
+    }
+    done = true;
+    for (auto& t : readers) {
+        t.join();
+    }
+    REQUIRE(torn == 0);
+    REQUIRE(backwards == 0);
+    REQUIRE(reads > 0);
+    REQUIRE(board.version(0) == 50000);
+}
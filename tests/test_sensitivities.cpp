@@ -0,0 +1,140 @@
+#include <catch2/catch_all.hpp>
+#include "bsm/sensitivities.h"
+#include "Greeks.h"
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+namespace {
+    struct Point {
+        double S, K, T, r, sigma, q;
+    };
+
+    const Point kPoints[] = {
+        {100.0, 100.0, 0.5, 0.03, 0.2, 0.01},
+        {100.0, 80.0, 1.5, 0.05, 0.35, 0.02},
+        {100.0, 125.0, 0.1, -0.01, 0.15, 0.0},
+        {50.0, 55.0, 3.0, 0.02, 0.6, 0.04},
+    };
+
+    bool close(double a, double b, double tol) {
+        return std::abs(a - b) <= tol * (1.0 + std::abs(b));
+    }
+
+    double& variable(Point& p, int i) {
+        switch (static_cast<SensitivityVariable>(i)) {
+            case SensitivityVariable::S: return p.S;
+            case SensitivityVariable::Sigma: return p.sigma;
+            case SensitivityVariable::R: return p.r;
+            case SensitivityVariable::Q: return p.q;
+            default: return p.T;
+        }
+    }
+}
+
+TEST_CASE("Sensitivities match the named Greeks", "[sensitivities]") {
+    ScalingParams raw = ScalingParams::no_scaling();
+    for (bool call : {true, false}) {
+        for (const Point& p : kPoints) {
+            PriceSensitivities s = price_sensitivities(call, p.S, p.K, p.T, p.r, p.sigma, p.q);
+            Greeks g = calculate_all(call, p.S, p.K, p.T, p.r, p.sigma, p.q, raw);
+            const double tol = 1e-12;
+            REQUIRE(close(s.price, g.price, tol));
+            REQUIRE(close(s.gradient[0], g.delta, tol));
+            REQUIRE(close(s.gradient[1], g.vega, tol));
+            REQUIRE(close(s.gradient[2], g.rho, tol));
+            REQUIRE(close(s.gradient[3], g.epsilon, tol));
+            REQUIRE(close(s.gradient[4], -g.theta, tol));
+            REQUIRE(close(s.hessian[0][0], g.gamma, tol));
+            REQUIRE(close(s.hessian[0][1], g.vanna, tol));
+            REQUIRE(close(s.hessian[0][4], -g.charm, tol));
+            REQUIRE(close(s.hessian[1][1], g.volga, tol));
+            REQUIRE(close(s.hessian[1][2], g.vera, tol));
+            REQUIRE(close(s.hessian[1][4], -g.veta, tol));
+            for (int i = 0; i < kSensitivityCount; ++i) {
+                for (int j = 0; j < kSensitivityCount; ++j) {
+                    REQUIRE(s.hessian[i][j] == s.hessian[j][i]);
+                }
+            }
+        }
+    }
+    REQUIRE_THROWS_AS(price_sensitivities(true, 100.0, 100.0, 0.0, 0.03, 0.2), std::invalid_argument);
+}
+
+TEST_CASE("Sensitivities match finite differences", "[sensitivities]") {
+    for (bool call : {true, false}) {
+        for (const Point& p : kPoints) {
+            PriceSensitivities s = price_sensitivities(call, p.S, p.K, p.T, p.r, p.sigma, p.q);
+            for (int j = 0; j < kSensitivityCount; ++j) {
+                Point up = p, down = p;
+                double h = 1e-4 * (j == 0 ? p.S : 1.0);
+                variable(up, j) += h;
+                variable(down, j) -= h;
+                PriceSensitivities a = price_sensitivities(call, up.S, up.K, up.T, up.r, up.sigma, up.q);
+                PriceSensitivities b = price_sensitivities(call, down.S, down.K, down.T, down.r, down.sigma, down.q);
+                double scale = std::abs(s.price) + p.S;
+                REQUIRE(std::abs((a.price - b.price) / (2.0 * h) - s.gradient[j]) < 1e-6 * scale);
+                for (int i = 0; i < kSensitivityCount; ++i) {
+                    double fd = (a.gradient[i] - b.gradient[i]) / (2.0 * h);
+                    REQUIRE(std::abs(fd - s.hessian[i][j]) < 1e-6 * scale);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Batch sensitivities write packed upper triangles", "[sensitivities]") {
+    REQUIRE(packed_hessian_index(0, 0) == 0);
+    REQUIRE(packed_hessian_index(0, 4) == 4);
+    REQUIRE(packed_hessian_index(1, 1) == 5);
+    REQUIRE(packed_hessian_index(2, 1) == 6);
+    REQUIRE(packed_hessian_index(4, 4) == kPackedHessianSize - 1);
+
+    std::vector<double> K = {80.0, 100.0, 120.0, -1.0};
+    std::vector<std::uint8_t> call = {1, 0, 1, 1};
+    double S = 100.0, T = 0.75, r = 0.02, sigma = 0.25, q = 0.01;
+    BatchInputs in;
+    in.count = K.size();
+    in.call = {call.data(), 1};
+    in.S = {&S, 0};
+    in.K = {K.data(), 1};
+    in.T = {&T, 0};
+    in.r = {&r, 0};
+    in.sigma = {&sigma, 0};
+    in.q = {&q, 0};
+
+    std::vector<double> price(K.size()), gradient(K.size() * kSensitivityCount), hessian(K.size() * kPackedHessianSize);
+    std::vector<std::int32_t> status(K.size());
+    SensitivityOutputs out;
+    out.price = {price.data(), 1};
+    out.gradient.data = gradient.data();
+    out.hessian.data = hessian.data();
+    out.status = {status.data(), 1};
+    REQUIRE(batch_price_sensitivities(in, out, 2) == 1);
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        REQUIRE(status[i] == static_cast<std::int32_t>(BatchStatus::Ok));
+        PriceSensitivities s = price_sensitivities(call[i] != 0, S, K[i], T, r, sigma, q);
+        REQUIRE(price[i] == s.price);
+        for (int a = 0; a < kSensitivityCount; ++a) {
+            REQUIRE(gradient[i * kSensitivityCount + a] == s.gradient[a]);
+            for (int b = 0; b < kSensitivityCount; ++b) {
+                REQUIRE(hessian[i * kPackedHessianSize + packed_hessian_index(a, b)] == s.hessian[a][b]);
+            }
+        }
+    }
+    REQUIRE(status[3] == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+    REQUIRE(std::isnan(price[3]));
+    REQUIRE(std::isnan(hessian[3 * kPackedHessianSize + 7]));
+
+    // Brace-initializing a view resets its stride to 1, so rows would overlap.
+    out.gradient = {gradient.data()};
+    REQUIRE_THROWS_AS(batch_price_sensitivities(in, out), std::invalid_argument);
+    out.gradient = {gradient.data(), kSensitivityCount};
+    out.hessian = {hessian.data(), kPackedHessianSize - 1};
+    REQUIRE_THROWS_AS(batch_price_sensitivities(in, out), std::invalid_argument);
+    out.hessian = {hessian.data(), kPackedHessianSize};
+    REQUIRE(batch_price_sensitivities(in, out) == 1);
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch_all.hpp>
+#include "service/client.h"
+#include "service/server.h"
+#include "Greeks.h"
+#include <string>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Local Pricing Service", "[service]") {
+    ServiceConfig config;
+    config.socket_path = "/tmp/oqg_test_" + std::to_string(::getpid()) + ".sock";
+    config.max_batch_delay = std::chrono::milliseconds(20);
+    config.threads = 2;
+
+    PricingServer server(config);
+    server.start();
+    PricingClient client(config.socket_path);
+
+    std::vector<WireContract> contracts(3);
+    double strikes[] = {90.0, 100.0, 110.0};
+    for (std::size_t i = 0; i < contracts.size(); ++i) {
+        contracts[i].S = 100.0;
+        contracts[i].K = strikes[i];
+        contracts[i].T = 0.5;
+        contracts[i].r = 0.03;
+        contracts[i].sigma = 0.25;
+        contracts[i].q = 0.01;
+        contracts[i].call = static_cast<std::uint8_t>(i != 1);
+    }
+    GreekMask columns = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Gamma);
+
+    SECTION("Concurrent identical requests are coalesced") {
+        std::uint32_t first = client.send_greeks(columns, contracts);
+        std::uint32_t second = client.send_greeks(greek_bit(GreekColumn::Delta), contracts);
+
+        for (int n = 0; n < 2; ++n) {
+            ServiceReply reply = client.receive();
+            REQUIRE(reply.type == MessageType::GreeksResponse);
+            REQUIRE(reply.status.size() == contracts.size());
+            for (std::size_t i = 0; i < contracts.size(); ++i) {
+                const WireContract& c = contracts[i];
+                REQUIRE(reply.status[i] == 0);
+                if (reply.request_id == first) {
+                    REQUIRE(reply.values[2 * i] == calculate_price(c.call, c.S, c.K, c.T, c.r, c.sigma, c.q));
+                    REQUIRE(reply.values[2 * i + 1] == calculate_gamma(c.S, c.K, c.T, c.r, c.sigma, c.q));
+                } else {
+                    REQUIRE(reply.request_id == second);
+                    REQUIRE(reply.values[i] == calculate_delta(c.call, c.S, c.K, c.T, c.r, c.sigma, c.q));
+                }
+            }
+        }
+        REQUIRE(server.metrics().coalesced.load() == contracts.size());
+        REQUIRE(server.metrics().batches.load() == 1);
+    }
+
+    SECTION("Implied volatility and invalid rows") {
+        std::vector<WireContract> quotes = contracts;
+        for (auto& c : quotes) {
+            c.sigma = calculate_price(c.call, c.S, c.K, c.T, c.r, 0.3, c.q);
+        }
+        quotes[2].S = -1.0;
+        ServiceReply reply = client.implied_vol(quotes);
+        REQUIRE(reply.type == MessageType::ImpliedVolResponse);
+        REQUIRE(std::abs(reply.values[0] - 0.3) < 1e-5);
+        REQUIRE(std::abs(reply.values[1] - 0.3) < 1e-5);
+        REQUIRE(reply.status[2] == 1);
+        REQUIRE(client.stats().find("end_to_end") != std::string::npos);
+    }
+
+    SECTION("A client that stops reading does not hold up the others") {
+        std::vector<WireContract> big(2000, contracts[0]);
+        for (std::size_t i = 0; i < big.size(); ++i) {
+            big[i].K = 50.0 + 0.05 * static_cast<double>(i);
+        }
+        // Each reply is about 460 KB, far more than the socket buffer takes.
+        PricingClient slow(config.socket_path);
+        for (int n = 0; n < 3; ++n) {
+            slow.send_greeks(kAllGreeks, big);
+        }
+        ServiceReply reply = client.greeks(columns, contracts);
+        REQUIRE(reply.status.size() == contracts.size());
+        for (int n = 0; n < 3; ++n) {
+            REQUIRE(slow.receive().status.size() == big.size());
+        }
+        REQUIRE(server.metrics().dropped.load() == 0);
+    }
+
+    SECTION("Requests whose reply would not fit a frame are rejected") {
+        // 240 bytes per row of reply against 56 per row of request.
+        std::size_t limit = (kMaxPayloadBytes - sizeof(RequestPrefix)) / (sizeof(WireStatus) + kGreekColumnCount * sizeof(double));
+        std::vector<WireContract> many(limit + 1, contracts[0]);
+        ServiceReply reply = client.greeks(kAllGreeks, many);
+        REQUIRE(reply.type == MessageType::ErrorResponse);
+        REQUIRE(reply.text.find("frame size limit") != std::string::npos);
+
+        many.resize(1000);
+        reply = client.greeks(kAllGreeks, many);
+        REQUIRE(reply.type == MessageType::GreeksResponse);
+        REQUIRE(reply.status.size() == many.size());
+    }
+
+    server.stop();
+}
+
+TEST_CASE("Local Pricing Service drops clients with a full outbox", "[service]") {
+    ServiceConfig config;
+    config.socket_path = "/tmp/oqg_test_drop_" + std::to_string(::getpid()) + ".sock";
+    config.max_batch_delay = std::chrono::microseconds(100);
+    config.max_outbox_bytes = 1 << 20;
+    config.threads = 2;
+
+    PricingServer server(config);
+    server.start();
+    PricingClient client(config.socket_path);
+    PricingClient slow(config.socket_path);
+
+    WireContract c;
+    c.S = 100.0;
+    c.K = 100.0;
+    c.T = 0.5;
+    c.r = 0.03;
+    c.sigma = 0.25;
+    std::vector<WireContract> big(2000, c);
+    for (std::size_t i = 0; i < big.size(); ++i) {
+        big[i].K = 50.0 + 0.05 * static_cast<double>(i);
+    }
+    for (int n = 0; n < 8; ++n) {
+        slow.send_greeks(kAllGreeks, big);
+    }
+    for (int i = 0; i < 200 && server.metrics().dropped.load() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    REQUIRE(server.metrics().dropped.load() == 1);
+
+    ServiceReply reply = client.greeks(greek_bit(GreekColumn::Delta), {c});
+    REQUIRE(reply.values[0] == calculate_delta(true, c.S, c.K, c.T, c.r, c.sigma, c.q));
+    REQUIRE_THROWS_AS(([&] {
+        while (true) {
+            slow.receive();
+        }
+    }()), std::runtime_error);
+
+    server.stop();
+}
+
+
+TEST_CASE("Local Pricing Service cleans up a failed start", "[service]") {
+    auto open_fds = [] {
+        int n = 0;
+        for (int fd = 0; fd < 1024; ++fd) {
+            n += ::fcntl(fd, F_GETFD) != -1;
+        }
+        return n;
+    };
+    ServiceConfig config;
+    config.socket_path = "/tmp/oqg_missing_dir_" + std::to_string(::getpid()) + "/server.sock";
+    int before = open_fds();
+    {
+        PricingServer server(config);
+        REQUIRE_THROWS_AS(server.start(), std::runtime_error);
+        REQUIRE_THROWS_AS(server.start(), std::runtime_error);
+    }
+    REQUIRE(open_fds() == before);
+}
\ No newline at end of file
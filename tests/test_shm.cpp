@@ -0,0 +1,122 @@
+#include <catch2/catch_all.hpp>
+#include "service/shm_store.h"
+#include "Greeks.h"
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Shared-memory Greek store", "[shm]") {
+    std::string name = "/oqg_test_" + std::to_string(::getpid());
+    GreekMask columns = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) | greek_bit(GreekColumn::Gamma);
+    ShmGreekProducer producer(name, 4, columns);
+    REQUIRE(producer.width() == 3);
+    REQUIRE(producer.add(77) == 0);
+    REQUIRE(producer.add(12) == 1);
+    REQUIRE(producer.add(77) == 0);
+    REQUIRE(producer.size() == 2);
+
+    ShmGreekReader reader(name);
+    REQUIRE(reader.capacity() == 4);
+    REQUIRE(reader.size() == 2);
+    REQUIRE(reader.columns() == columns);
+    REQUIRE(reader.find(12) == 1);
+    REQUIRE(reader.find(13) == -1);
+    REQUIRE(!reader.closed());
+
+    Greeks g = calculate_all(false, 100.0, 95.0, 0.75, 0.02, 0.3, 0.01);
+
+    SECTION("Round trip with staleness stamp") {
+        Greeks out;
+        REQUIRE(!reader.read(1, out));
+        std::int64_t before = shm_clock_ns();
+        producer.publish(1, g);
+        std::int64_t updated = 0;
+        REQUIRE(reader.read(1, out, &updated));
+        REQUIRE(updated >= before);
+        REQUIRE(updated <= shm_clock_ns());
+        REQUIRE(reader.version(1) == 1);
+        REQUIRE(out.price == g.price);
+        REQUIRE(out.delta == g.delta);
+        REQUIRE(out.gamma == g.gamma);
+        REQUIRE(std::isnan(out.vega));
+
+        REQUIRE(reader.heartbeat_ns() == 0);
+        producer.heartbeat();
+        REQUIRE(reader.heartbeat_ns() >= before);
+    }
+
+    SECTION("Another process reads in place") {
+        producer.publish(0, g);
+        pid_t child = ::fork();
+        if (child == 0) {
+            int code = 1;
+            try {
+                ShmGreekReader other(name);
+                long slot = other.find(77);
+                double values[3];
+                if (slot == 0 && other.read(static_cast<std::size_t>(slot), values) && values[0] == g.price &&
+                    values[1] == g.delta && values[2] == g.gamma) {
+                    code = 0;
+                }
+            } catch (...) {
+            }
+            ::_exit(code);
+        }
+        REQUIRE(child > 0);
+        int status = 0;
+        REQUIRE(::waitpid(child, &status, 0) == child);
+        REQUIRE(WIFEXITED(status));
+        REQUIRE(WEXITSTATUS(status) == 0);
+    }
+
+    SECTION("Batch publication") {
+        std::vector<double> S = {100.0, 100.0}, K = {90.0, -1.0}, T = {0.5, 0.5}, r = {0.03, 0.03}, sigma = {0.2, 0.2};
+        std::vector<std::uint32_t> slots = {1, 0};
+        BatchInputs in;
+        in.count = 2;
+        in.S = {S.data()};
+        in.K = {K.data()};
+        in.T = {T.data()};
+        in.r = {r.data()};
+        in.sigma = {sigma.data()};
+        REQUIRE(producer.publish_batch(in, {slots.data()}, ScalingParams::no_scaling(), 1) == 1);
+        Greeks out;
+        REQUIRE(reader.read(1, out));
+        REQUIRE(std::abs(out.price - calculate_price(true, 100.0, 90.0, 0.5, 0.03, 0.2)) < 1e-12);
+        REQUIRE(!reader.read(0, out));
+    }
+
+    SECTION("Capacity and unknown stores") {
+        producer.add(3);
+        producer.add(4);
+        REQUIRE_THROWS_AS(producer.add(5), std::length_error);
+        REQUIRE_THROWS_AS(producer.publish(4, g), std::out_of_range);
+        REQUIRE_THROWS_AS(ShmGreekReader(name + "_missing"), std::runtime_error);
+    }
+
+    SECTION("Replacing the producer closes the old segment") {
+        ShmGreekProducer replacement(name, 2, columns);
+        REQUIRE(reader.closed());
+        ShmGreekReader fresh(name);
+        REQUIRE(!fresh.closed());
+        REQUIRE(fresh.size() == 0);
+    }
+}
+
+TEST_CASE("Shared-memory store is closed when the producer goes", "[shm]") {
+    std::string name = "oqg_test_close_" + std::to_string(::getpid());
+    auto producer = std::make_unique<ShmGreekProducer>(name, 1);
+    ShmGreekReader reader(name);
+    producer->publish(producer->add(1), Greeks{});
+    producer.reset();
+    REQUIRE(reader.closed());
+    Greeks out;
+    REQUIRE(reader.read(0, out));
+    REQUIRE_THROWS_AS(ShmGreekReader(name), std::runtime_error);
+}
@@ -0,0 +1,163 @@
+#include <catch2/catch_all.hpp>
+#include "snapshot/snapshot.h"
+#include "Greeks.h"
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <iterator>
+
+using namespace GreeksCalculator;
+
+namespace {
+    constexpr double kYear = 365.0 * 86400.0;
+
+    void fill(ContractStateStore& store, std::uint64_t count) {
+        for (std::uint64_t id = 0; id < count; ++id) {
+            double K = 80.0 + static_cast<double>(id % 41);
+            store.update(id, id % 2 == 0, 100.0, K, 0.25 + 0.01 * static_cast<double>(id % 7), 0.03, 0.2, 0.01, 1000.0);
+        }
+    }
+
+    bool same_bits(const ContractState& a, const ContractState& b) {
+        return std::memcmp(&a, &b, sizeof(ContractState)) == 0;
+    }
+}
+
+TEST_CASE("Contract state evaluation", "[snapshot]") {
+    ContractState s;
+    s.flags = kStateCall;
+    s.S = 100.0; s.K = 105.0; s.T = 0.5; s.r = 0.03; s.q = 0.01; s.sigma = 0.25;
+
+    REQUIRE(evaluate_contract_state(s, ScalingParams::standard()) == BatchStatus::Ok);
+    Greeks expected = calculate_all(true, 100.0, 105.0, 0.5, 0.03, 0.25, 0.01);
+    REQUIRE(s.greeks.price == expected.price);
+    REQUIRE(s.greeks.gamma == expected.gamma);
+    REQUIRE(s.greeks.vanna == expected.vanna);
+    REQUIRE(s.sqrt_T == std::sqrt(0.5));
+    REQUIRE(s.discount_r == std::exp(-0.03 * 0.5));
+    REQUIRE(s.discount_q == std::exp(-0.01 * 0.5));
+
+    SECTION("Implied volatility from a market price") {
+        s.market_price = expected.price;
+        s.sigma = 0.0;
+        REQUIRE(evaluate_contract_state(s, ScalingParams::standard()) == BatchStatus::Ok);
+        REQUIRE(std::abs(s.sigma - 0.25) < 1e-6);
+    }
+
+    SECTION("Invalid inputs") {
+        s.T = -1.0;
+        REQUIRE(evaluate_contract_state(s, ScalingParams::standard()) == BatchStatus::InvalidInput);
+        REQUIRE(s.status == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+        REQUIRE(std::isnan(s.greeks.delta));
+    }
+}
+
+TEST_CASE("Contract state snapshots", "[snapshot]") {
+    std::string path = "contract_state_test.snap";
+    ContractStateStore store;
+    fill(store, 500);
+    store.update_price(1000, false, 100.0, 95.0, 0.5, 0.03, 2.5, 0.0, 1000.0);
+    store.save(path);
+
+    SECTION("Round trip through a mapped view") {
+        SnapshotView view = SnapshotView::open(path);
+        REQUIRE(view.size() == 501);
+        REQUIRE(view.created() > 0.0);
+        for (std::size_t i = 0; i < view.size(); ++i) {
+            ContractState live;
+            REQUIRE(store.get(view.records()[i].id, live));
+            REQUIRE(same_bits(live, view.records()[i]));
+        }
+    }
+
+    SECTION("Restore serves the stored state until it is refreshed") {
+        ContractStateStore restarted;
+        REQUIRE(restarted.restore(path) == 501);
+        REQUIRE(restarted.restored() == 501);
+
+        ContractState before, after;
+        REQUIRE(store.get(7, before));
+        REQUIRE(restarted.get(7, after));
+        REQUIRE(after.restored());
+        after.flags &= ~kStateRestored;
+        REQUIRE(same_bits(before, after));
+        REQUIRE(restarted.get(1000, after));
+        REQUIRE(after.market_price == 2.5);
+        REQUIRE(std::isfinite(after.sigma));
+
+        // A live update replaces the restored record.
+        REQUIRE(restarted.update(7, false, 101.0, 90.0, 0.3, 0.03, 0.3, 0.0, 2000.0) == BatchStatus::Ok);
+        REQUIRE(restarted.get(7, after));
+        REQUIRE(!after.restored());
+        REQUIRE(after.S == 101.0);
+        REQUIRE(restarted.restored() == 500);
+
+        // Lazy refresh ages T by the elapsed time and skips contracts already updated.
+        double later = 1000.0 + 0.1 * kYear;
+        std::size_t refreshed = 0, step;
+        while ((step = restarted.refresh_restored(64, later, kYear, 2)) > 0) {
+            refreshed += step;
+        }
+        REQUIRE(refreshed == 500);
+        REQUIRE(restarted.restored() == 0);
+        REQUIRE(restarted.get(7, after));
+        REQUIRE(after.S == 101.0);
+
+        REQUIRE(store.get(8, before));
+        REQUIRE(restarted.get(8, after));
+        REQUIRE(!after.restored());
+        REQUIRE(after.updated == later);
+        REQUIRE(std::abs(after.T - (before.T - 0.1)) < 1e-12);
+        Greeks expected = calculate_all(true, 100.0, before.K, after.T, 0.03, 0.2, 0.01);
+        REQUIRE(after.greeks.delta == expected.delta);
+        REQUIRE(after.greeks.theta == expected.theta);
+    }
+
+    SECTION("Corrupt, truncated and mismatched files are rejected") {
+        {
+            std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+            file.seekp(1000);
+            file.put('\x7f');
+        }
+        REQUIRE_THROWS_AS(SnapshotView::open(path), std::runtime_error);
+        REQUIRE_NOTHROW(SnapshotView::open(path, false));
+
+        store.save(path);
+        ContractStateStore daily(ScalingParams::no_scaling());
+        REQUIRE_THROWS_AS(daily.restore(path), std::runtime_error);
+
+        {
+            std::ifstream in(path, std::ios::binary);
+            std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), static_cast<std::streamsize>(bytes.size() - 8));
+        }
+        REQUIRE_THROWS_AS(SnapshotView::open(path), std::runtime_error);
+        REQUIRE_THROWS_AS(SnapshotView::open("no_such_snapshot.snap"), std::runtime_error);
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Background snapshots while updating", "[snapshot]") {
+    std::string path = "contract_state_background.snap";
+    ContractStateStore store;
+    fill(store, 200);
+    store.start_snapshots(path, std::chrono::milliseconds(2));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    for (int i = 0; store.snapshots_written() < 3 && std::chrono::steady_clock::now() < deadline; ++i) {
+        store.update(static_cast<std::uint64_t>(i % 300), true, 100.0 + i % 5, 100.0, 0.5, 0.03, 0.2, 0.0, 1000.0 + i);
+    }
+    store.stop_snapshots();
+    REQUIRE(store.snapshots_written() >= 3);
+    REQUIRE(store.snapshot_failures() == 0);
+
+    SnapshotView view = SnapshotView::open(path);
+    REQUIRE(view.size() >= 200);
+    REQUIRE(view.size() <= 300);
+    std::remove(path.c_str());
+}
@@ -0,0 +1,116 @@
+#include <catch2/catch_all.hpp>
+#include "bsm/strike_from_delta.h"
+#include "math/cdf.h"
+#include "math/pdf.h"
+#include "surface/svi.h"
+#include "Greeks.h"
+#include <cmath>
+#include <vector>
+
+using namespace GreeksCalculator;
+
+TEST_CASE("Inverse Normal CDF", "[strike]") {
+    for (double x = -30.0; x <= 5.0; x += 0.01) {
+        // Above zero, rounding p near 1 already moves x by about eps / phi(x).
+        double conditioning = x > 0.0 ? 2.2e-16 / normal_pdf(x) : 0.0;
+        REQUIRE(std::abs(inverse_normal_cdf(normal_cdf(x)) - x) < 1e-14 * std::max(1.0, std::abs(x)) + conditioning);
+    }
+    REQUIRE(inverse_normal_cdf(0.5) == 0.0);
+    REQUIRE(std::isinf(inverse_normal_cdf(0.0)));
+    REQUIRE(std::isnan(inverse_normal_cdf(1.5)));
+}
+
+TEST_CASE("Strike From Delta", "[strike]") {
+    const DeltaConvention conventions[] = {DeltaConvention::Spot, DeltaConvention::Forward, DeltaConvention::SpotPremiumAdjusted,
+                                           DeltaConvention::ForwardPremiumAdjusted};
+    double S = 1.25, r = 0.045, q = 0.03;
+
+    SECTION("Spot delta is calculate_delta") {
+        for (bool call : {true, false}) {
+            REQUIRE(convention_delta(call, S, 1.3, 0.5, r, 0.1, q, DeltaConvention::Spot) == calculate_delta(call, S, 1.3, 0.5, r, 0.1, q));
+        }
+    }
+
+    SECTION("Round trip in every convention") {
+        for (DeltaConvention convention : conventions) {
+            for (double T : {1.0 / 52.0, 0.5, 2.0}) {
+                for (double sigma : {0.05, 0.12, 0.4}) {
+                    for (double delta : {0.05, 0.1, 0.25, 0.5, 0.75}) {
+                        for (bool call : {true, false}) {
+                            double signed_delta = call ? delta : -delta;
+                            double K = strike_from_delta(call, signed_delta, S, T, r, sigma, q, convention);
+                            INFO("convention " << static_cast<int>(convention) << " T " << T << " sigma " << sigma << " delta " << signed_delta);
+                            if (call && (convention == DeltaConvention::SpotPremiumAdjusted ||
+                                         convention == DeltaConvention::ForwardPremiumAdjusted) && std::isnan(K)) {
+                                continue;    // Above the premium-adjusted maximum
+                            }
+                            REQUIRE(K > 0.0);
+                            REQUIRE(std::abs(convention_delta(call, S, K, T, r, sigma, q, convention) - signed_delta) < 1e-13);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    SECTION("Premium-adjusted call picks the strike above the peak") {
+        double T = 1.0, sigma = 0.4;
+        double K = strike_from_delta(true, 0.25, S, T, r, sigma, q, DeltaConvention::ForwardPremiumAdjusted);
+        double bump = 1e-6 * K;
+        REQUIRE(convention_delta(true, S, K + bump, T, r, sigma, q, DeltaConvention::ForwardPremiumAdjusted) < 0.25);
+        // The peak of a 40% vol one-year premium-adjusted call delta is well below 0.75.
+        REQUIRE(std::isnan(strike_from_delta(true, 0.75, S, T, r, sigma, q, DeltaConvention::ForwardPremiumAdjusted)));
+    }
+
+    SECTION("Rejects unattainable deltas") {
+        REQUIRE(std::isnan(strike_from_delta(true, -0.25, S, 1.0, r, 0.1, q)));
+        REQUIRE(std::isnan(strike_from_delta(false, 0.25, S, 1.0, r, 0.1, q)));
+        REQUIRE(std::isnan(strike_from_delta(true, 0.99, S, 1.0, r, 0.1, q)));    // Above exp(-qT)
+        REQUIRE(std::isnan(strike_from_delta(true, 0.25, S, 1.0, r, -0.1, q)));
+    }
+}
+
+TEST_CASE("Strike From Delta On A Smile", "[strike]") {
+    double S = 100.0, r = 0.02, q = 0.0;
+    SviSurface surface({{0.25, S * std::exp(r * 0.25), ssvi_slice(0.01, 2.0, -0.5)},
+                        {1.0, S * std::exp(r), ssvi_slice(0.045, 1.2, -0.4)}});
+
+    for (double T : {0.25, 0.6, 1.0}) {
+        for (double delta : {0.1, 0.25, -0.25, -0.1}) {
+            bool call = delta > 0.0;
+            double K = strike_from_delta(call, delta, S, T, r, q, DeltaConvention::Forward,
+                                         [&](double strike) { return surface.volatility(strike, T); });
+            REQUIRE(std::abs(convention_delta(call, S, K, T, r, surface.volatility(K, T), q, DeltaConvention::Forward) - delta) < 1e-12);
+        }
+    }
+
+    SECTION("Batch") {
+        std::vector<double> delta = {0.25, -0.25, 0.1, 1.5}, T = {0.25, 0.5, 1.0, 1.0}, sigma = {0.2, 0.2, 0.3, 0.2};
+        std::vector<double> strike(4), smile(4);
+        std::vector<std::uint8_t> call = {1, 0, 1, 1};
+        std::vector<std::int32_t> status(4);
+        DeltaStrikeInputs in;
+        in.count = 4;
+        in.call = {call.data()};
+        in.delta = {delta.data()};
+        in.S = {&S, 0};
+        in.T = {T.data()};
+        in.r = {&r, 0};
+        in.sigma = {sigma.data()};
+
+        REQUIRE(batch_strike_from_delta(in, {strike.data()}, {status.data()}, DeltaConvention::Spot, 2) == 1);
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE(status[i] == 0);
+            REQUIRE(strike[i] == strike_from_delta(call[i] != 0, delta[i], S, T[i], r, sigma[i], q));
+        }
+        REQUIRE(std::isnan(strike[3]));
+        REQUIRE(status[3] == static_cast<std::int32_t>(BatchStatus::InvalidInput));
+
+        auto vol = [&](double K, double expiry) { return surface.volatility(K, expiry); };
+        REQUIRE(batch_strike_from_delta(in, vol, {smile.data()}, {status.data()}, DeltaConvention::Spot) == 1);
+        for (std::size_t i = 0; i < 3; ++i) {
+            REQUIRE(smile[i] == strike_from_delta(call[i] != 0, delta[i], S, T[i], r, q, DeltaConvention::Spot,
+                                                  [&](double K) { return surface.volatility(K, T[i]); }));
+        }
+    }
+}
@@ -0,0 +1,137 @@
+// Load generator for greeksd: pipelined Greek requests over several connections,
+// drawn from a fixed contract universe so that concurrent requests overlap.
+#include "service/client.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace GreeksCalculator;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    struct Options {
+        std::string socket_path = "/tmp/openquantgreeks.sock";
+        int connections = 4;
+        int requests = 10000;        // Per connection
+        int batch = 16;              // Contracts per request
+        int universe = 1000;         // Distinct contracts
+        int inflight = 8;            // Outstanding requests per connection
+        std::uint64_t seed = 1;
+    };
+
+    std::vector<WireContract> make_universe(const Options& opt) {
+        std::mt19937_64 rng(opt.seed);
+        std::uniform_real_distribution<double> strike(80.0, 120.0), expiry(0.05, 2.0), vol(0.1, 0.5);
+        std::vector<WireContract> u(static_cast<std::size_t>(opt.universe));
+        for (std::size_t i = 0; i < u.size(); ++i) {
+            u[i].S = 100.0;
+            u[i].K = std::round(strike(rng));
+            u[i].T = expiry(rng);
+            u[i].r = 0.03;
+            u[i].sigma = vol(rng);
+            u[i].q = 0.01;
+            u[i].call = static_cast<std::uint8_t>(i % 2);
+        }
+        return u;
+    }
+
+    void run_connection(const Options& opt, const std::vector<WireContract>& universe, int id, std::vector<double>& latencies_us) {
+        PricingClient client(opt.socket_path);
+        std::mt19937_64 rng(opt.seed * 7919 + static_cast<std::uint64_t>(id));
+        std::uniform_int_distribution<std::size_t> pick(0, universe.size() - 1);
+        GreekMask columns = greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) |
+                            greek_bit(GreekColumn::Gamma) | greek_bit(GreekColumn::Vega);
+
+        std::unordered_map<std::uint32_t, Clock::time_point> sent;
+        std::vector<WireContract> request(static_cast<std::size_t>(opt.batch));
+        int issued = 0, completed = 0;
+        latencies_us.reserve(static_cast<std::size_t>(opt.requests));
+
+        while (completed < opt.requests) {
+            while (issued < opt.requests && issued - completed < opt.inflight) {
+                for (auto& c : request) {
+                    c = universe[pick(rng)];
+                }
+                sent[client.send_greeks(columns, request)] = Clock::now();
+                ++issued;
+            }
+            ServiceReply reply = client.receive();
+            auto it = sent.find(reply.request_id);
+            if (it != sent.end()) {
+                latencies_us.push_back(std::chrono::duration<double, std::micro>(Clock::now() - it->second).count());
+                sent.erase(it);
+            }
+            ++completed;
+        }
+    }
+
+    double percentile(std::vector<double>& v, double p) {
+        if (v.empty()) {
+            return 0.0;
+        }
+        std::size_t k = std::min(v.size() - 1, static_cast<std::size_t>(p * static_cast<double>(v.size())));
+        std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+        return v[k];
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char* arg = argv[i];
+        const char* value = argv[i + 1];
+        if (std::strcmp(arg, "--socket") == 0) opt.socket_path = value;
+        else if (std::strcmp(arg, "--connections") == 0) opt.connections = std::atoi(value);
+        else if (std::strcmp(arg, "--requests") == 0) opt.requests = std::atoi(value);
+        else if (std::strcmp(arg, "--batch") == 0) opt.batch = std::atoi(value);
+        else if (std::strcmp(arg, "--universe") == 0) opt.universe = std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--inflight") == 0) opt.inflight = std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--seed") == 0) opt.seed = std::strtoull(value, nullptr, 10);
+        else {
+            std::fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+    }
+
+    std::vector<WireContract> universe = make_universe(opt);
+    std::vector<std::vector<double>> latencies(static_cast<std::size_t>(opt.connections));
+    std::vector<std::thread> threads;
+
+    Clock::time_point start = Clock::now();
+    try {
+        for (int c = 0; c < opt.connections; ++c) {
+            threads.emplace_back(run_connection, std::cref(opt), std::cref(universe), c, std::ref(latencies[static_cast<std::size_t>(c)]));
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "greeks_loadgen: %s\n", e.what());
+        return 1;
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto& l : latencies) {
+        all.insert(all.end(), l.begin(), l.end());
+    }
+    double requests = static_cast<double>(all.size());
+    std::printf("requests=%.0f contracts=%.0f elapsed=%.3fs\n", requests, requests * opt.batch, seconds);
+    std::printf("throughput: %.0f requests/s, %.0f contracts/s\n", requests / seconds, requests * opt.batch / seconds);
+    std::printf("latency: p50=%.1fus p99=%.1fus p99.9=%.1fus max=%.1fus\n", percentile(all, 0.50), percentile(all, 0.99),
+                percentile(all, 0.999), percentile(all, 1.0));
+
+    try {
+        PricingClient client(opt.socket_path);
+        std::printf("server:\n%s", client.stats().c_str());
+    } catch (const std::exception&) {
+    }
+    return 0;
+}
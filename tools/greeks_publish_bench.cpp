@@ -0,0 +1,167 @@
+// Contention benchmark for GreekPublisher: one writer republishes a small set of hot
+// contracts as fast as it can while reader threads read them, compared with the same
+// workload on mutex-protected Greeks records.
+#include "publish/publisher.h"
+#include "Greeks.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace GreeksCalculator;
+using Clock = std::chrono::steady_clock;
+
+namespace {
+    struct Options {
+        int contracts = 10000;
+        int hot = 16;                // Contracts the writer updates and readers read
+        int readers = 8;
+        double seconds = 2.0;        // Per variant
+        bool core_columns = false;   // Price, delta, gamma and vega instead of every column
+    };
+
+    struct Result {
+        double reads_per_second = 0.0;
+        std::uint64_t publishes = 0;
+        std::vector<double> latencies_ns;
+    };
+
+    // One Greeks record and its mutex per contract: what the publisher replaces.
+    struct MutexBoard {
+        struct alignas(64) Slot {
+            std::mutex mutex;
+            Greeks greeks;
+            double timestamp = 0.0;
+        };
+        std::vector<Slot> slots;
+
+        explicit MutexBoard(std::size_t n) : slots(n) {}
+
+        void publish(std::size_t i, const Greeks& g, double timestamp) {
+            std::lock_guard<std::mutex> lock(slots[i].mutex);
+            slots[i].greeks = g;
+            slots[i].timestamp = timestamp;
+        }
+        bool read(std::size_t i, Greeks& out) {
+            std::lock_guard<std::mutex> lock(slots[i].mutex);
+            out = slots[i].greeks;
+            return true;
+        }
+    };
+
+    double percentile(std::vector<double>& v, double p) {
+        if (v.empty()) {
+            return 0.0;
+        }
+        std::size_t k = std::min(v.size() - 1, static_cast<std::size_t>(p * static_cast<double>(v.size())));
+        std::nth_element(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(k), v.end());
+        return v[k];
+    }
+
+    // Runs the writer on the calling thread and opt.readers reader threads for opt.seconds.
+    template <typename Board>
+    Result run(const Options& opt, Board& board) {
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> reads{0};
+        std::vector<std::thread> readers;
+        for (int t = 0; t < opt.readers; ++t) {
+            readers.emplace_back([&, t] {
+                std::mt19937 rng(static_cast<unsigned>(t) + 1);
+                std::uniform_int_distribution<int> pick(0, opt.hot - 1);
+                Greeks out;
+                std::uint64_t n = 0;
+                double sink = 0.0;
+                while (!stop.load(std::memory_order_relaxed)) {
+                    for (int i = 0; i < 64; ++i) {
+                        if (board.read(static_cast<std::size_t>(pick(rng)), out)) {
+                            sink += out.price;
+                        }
+                    }
+                    n += 64;
+                }
+                volatile double keep = sink;    // Keeps the reads from being optimized away
+                (void)keep;
+                reads.fetch_add(n);
+            });
+        }
+
+        Result result;
+        Greeks g = calculate_all(true, 100.0, 100.0, 0.5, 0.03, 0.2, 0.01);
+        result.latencies_ns.reserve(1u << 22);
+        Clock::time_point start = Clock::now(), end = start + std::chrono::duration_cast<Clock::duration>(
+                                                                   std::chrono::duration<double>(opt.seconds));
+        for (std::uint64_t i = 0;; ++i) {
+            g.price = static_cast<double>(i);
+            Clock::time_point before = Clock::now();
+            board.publish(static_cast<std::size_t>(i % static_cast<std::uint64_t>(opt.hot)), g, static_cast<double>(i));
+            Clock::time_point after = Clock::now();
+            if (result.latencies_ns.size() < result.latencies_ns.capacity()) {
+                result.latencies_ns.push_back(std::chrono::duration<double, std::nano>(after - before).count());
+            }
+            ++result.publishes;
+            if (after >= end) {
+                break;
+            }
+        }
+        stop = true;
+        for (auto& t : readers) {
+            t.join();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        result.reads_per_second = static_cast<double>(reads.load()) / elapsed;
+        return result;
+    }
+
+    void report(const char* name, Result& r, const Options& opt) {
+        std::printf("%-8s reads: %.3g/s total, %.3g/s per reader   publishes: %.3g/s   publish latency: p50=%.0fns p99=%.0fns p99.9=%.0fns max=%.0fns\n",
+                    name, r.reads_per_second, r.reads_per_second / std::max(1, opt.readers),
+                    static_cast<double>(r.publishes) / opt.seconds, percentile(r.latencies_ns, 0.50),
+                    percentile(r.latencies_ns, 0.99), percentile(r.latencies_ns, 0.999), percentile(r.latencies_ns, 1.0));
+    }
+}
+
+int main(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--core") == 0) { opt.core_columns = true; continue; }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "missing value for %s\n", arg);
+            return 2;
+        }
+        const char* value = argv[++i];
+        if (std::strcmp(arg, "--contracts") == 0) opt.contracts = std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--hot") == 0) opt.hot = std::max(1, std::atoi(value));
+        else if (std::strcmp(arg, "--readers") == 0) opt.readers = std::max(0, std::atoi(value));
+        else if (std::strcmp(arg, "--seconds") == 0) opt.seconds = std::max(0.01, std::atof(value));
+        else {
+            std::fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+    }
+    opt.hot = std::min(opt.hot, opt.contracts);
+
+    std::vector<std::uint64_t> ids(static_cast<std::size_t>(opt.contracts));
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        ids[i] = 1000000 + i;
+    }
+    GreekMask columns = opt.core_columns ? greek_bit(GreekColumn::Price) | greek_bit(GreekColumn::Delta) |
+                                               greek_bit(GreekColumn::Gamma) | greek_bit(GreekColumn::Vega)
+                                         : kAllGreeks;
+    GreekPublisher publisher(ids, columns);
+    MutexBoard mutexes(ids.size());
+
+    std::printf("contracts=%d hot=%d readers=%d columns=%zu seconds=%.2f (latencies include two clock reads)\n",
+                opt.contracts, opt.hot, opt.readers, publisher.width(), opt.seconds);
+    Result seqlock = run(opt, publisher);
+    report("seqlock", seqlock, opt);
+    Result mutex = run(opt, mutexes);
+    report("mutex", mutex, opt);
+    return 0;
+}
@@ -0,0 +1,82 @@
+// Local pricing daemon: serves Greek and implied-volatility requests over a Unix-domain socket.
+#include "service/server.h"
+#include <atomic>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+using namespace GreeksCalculator;
+
+namespace {
+    std::atomic<bool> g_stop{false};
+
+    void on_signal(int) {
+        g_stop = true;
+    }
+
+    void usage(const char* argv0) {
+        std::fprintf(stderr,
+                     "usage: %s [--socket PATH] [--max-delay-us N] [--max-batch N] [--max-outbox-mb N] [--threads N]\n"
+                     "          [--stats-interval SEC]\n",
+                     argv0);
+    }
+}
+
+int main(int argc, char** argv) {
+    ServiceConfig config;
+    int stats_interval = 10;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (!value) {
+            usage(argv[0]);
+            return 2;
+        }
+        if (std::strcmp(arg, "--socket") == 0) {
+            config.socket_path = value;
+        } else if (std::strcmp(arg, "--max-delay-us") == 0) {
+            config.max_batch_delay = std::chrono::microseconds(std::atol(value));
+        } else if (std::strcmp(arg, "--max-batch") == 0) {
+            config.max_batch_size = static_cast<std::size_t>(std::atol(value));
+        } else if (std::strcmp(arg, "--max-outbox-mb") == 0) {
+            config.max_outbox_bytes = static_cast<std::size_t>(std::atol(value)) << 20;
+        } else if (std::strcmp(arg, "--threads") == 0) {
+            config.threads = std::atoi(value);
+        } else if (std::strcmp(arg, "--stats-interval") == 0) {
+            stats_interval = std::atoi(value);
+        } else {
+            usage(argv[0]);
+            return 2;
+        }
+        ++i;
+    }
+
+    std::signal(SIGINT, on_signal);
+    std::signal(SIGTERM, on_signal);
+
+    PricingServer server(config);
+    try {
+        server.start();
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "greeksd: %s\n", e.what());
+        return 1;
+    }
+    std::fprintf(stderr, "greeksd: listening on %s (max delay %lldus, max batch %zu)\n", config.socket_path.c_str(),
+                 static_cast<long long>(config.max_batch_delay.count()), config.max_batch_size);
+
+    auto next_report = std::chrono::steady_clock::now() + std::chrono::seconds(stats_interval);
+    while (!g_stop) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (stats_interval > 0 && std::chrono::steady_clock::now() >= next_report) {
+            std::fprintf(stderr, "%s", server.metrics().report().c_str());
+            next_report += std::chrono::seconds(stats_interval);
+        }
+    }
+
+    server.stop();
+    std::fprintf(stderr, "%s", server.metrics().report().c_str());
+    return 0;
+}